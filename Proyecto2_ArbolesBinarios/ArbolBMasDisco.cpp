@@ -0,0 +1,760 @@
+#include "ArbolBMasDisco.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * @brief Valor de CabeceraNodo::tipo para hojas.
+ */
+static const uint16_t TIPO_HOJA = 1;
+
+/**
+ * @brief Valor de CabeceraNodo::tipo para nodos internos.
+ */
+static const uint16_t TIPO_INTERNO = 2;
+
+/**
+ * @brief Identificador del archivo de índice: los bytes 'A','B','B','D' en little-endian.
+ */
+static const uint32_t MAGIA_INDICE = 0x44424241;
+
+/**
+ * @brief Versión del formato de páginas.
+ */
+static const uint32_t VERSION_INDICE = 1;
+
+/**
+ * @brief Contenido de la página 0 del archivo de índice.
+ */
+struct CabeceraArchivo {
+    uint32_t magia;
+    uint32_t version;
+    uint32_t tamano_pagina;
+    uint32_t raiz;
+    uint32_t cantidad_paginas;
+    uint32_t altura;
+    uint64_t cantidad_registros;
+    uint64_t bytes_datos;
+};
+
+/**
+ * @brief Abre un archivo para lectura y escritura, creándolo si no existe.
+ * @param archivo Flujo a abrir.
+ * @param ruta Ruta del archivo.
+ * @throws std::runtime_error si no se puede abrir.
+ */
+static void abrir_archivo(fstream& archivo, const string& ruta) {
+    { ofstream crear(ruta, ios::binary | ios::app); }
+    archivo.open(ruta, ios::in | ios::out | ios::binary);
+    if (!archivo) throw runtime_error("ArbolBMasDisco: no se pudo abrir " + ruta);
+}
+
+// ---------- Página fijada ----------
+
+/**
+ * @brief Fija la página en el pool del árbol.
+ * @param arbol Árbol dueño del pool.
+ * @param numero Página a fijar.
+ */
+ArbolBMasDisco::PaginaFijada::PaginaFijada(ArbolBMasDisco& arbol, uint32_t numero)
+    : arbol_(&arbol), marco_(arbol.fijar(numero)) {
+}
+
+/**
+ * @brief Suelta la fijación.
+ */
+ArbolBMasDisco::PaginaFijada::~PaginaFijada() { arbol_->soltar(marco_); }
+
+/**
+ * @brief Página fijada.
+ * @return Referencia válida mientras exista este objeto.
+ */
+ArbolBMasDisco::Pagina& ArbolBMasDisco::PaginaFijada::pagina() const { return arbol_->marcos_[marco_].pagina; }
+
+/**
+ * @brief Marca la página como modificada.
+ */
+void ArbolBMasDisco::PaginaFijada::marcar_sucia() const { arbol_->marcos_[marco_].sucia = true; }
+
+// ---------- Construcción ----------
+
+/**
+ * @brief Abre o crea el árbol.
+ * @param ruta_base Ruta sin extensión.
+ * @param paginas_en_memoria Marcos del pool.
+ * @details
+ * Un archivo de índice vacío se inicializa con la cabecera y una hoja raíz
+ * vacía; uno existente se valida contra la magia, la versión y el tamaño de
+ * página antes de retomar su estado.
+ */
+ArbolBMasDisco::ArbolBMasDisco(const string& ruta_base, size_t paginas_en_memoria)
+    : raiz_(0), cantidad_paginas_(0), altura_(0), cantidad_registros_(0), bytes_datos_(0),
+    marcos_(std::max<size_t>(paginas_en_memoria, 8)), aciertos_(0), lecturas_(0), escrituras_(0) {
+    for (size_t marco = 0; marco < marcos_.size(); ++marco) {
+        orden_lru_.push_back(marco);
+        marcos_[marco].lru = prev(orden_lru_.end());
+    }
+
+    abrir_archivo(indice_, ruta_base + ".idx");
+    abrir_archivo(datos_, ruta_base + ".dat");
+
+    indice_.seekg(0, ios::end);
+    if (indice_.tellg() == streampos(0)) {
+        cantidad_paginas_ = 1;
+        raiz_ = nueva_pagina();
+        PaginaFijada raiz(*this, raiz_);
+        raiz.pagina().hoja.cabecera.tipo = TIPO_HOJA;
+        raiz.marcar_sucia();
+        altura_ = 1;
+        return;
+    }
+
+    Pagina pagina;
+    leer_pagina(0, pagina);
+    CabeceraArchivo cabecera;
+    memcpy(&cabecera, pagina.bytes, sizeof(cabecera));
+    if (cabecera.magia != MAGIA_INDICE || cabecera.version != VERSION_INDICE || cabecera.tamano_pagina != TAMANO_PAGINA) {
+        throw runtime_error("ArbolBMasDisco: " + ruta_base + ".idx no tiene el formato esperado");
+    }
+    raiz_ = cabecera.raiz;
+    cantidad_paginas_ = cabecera.cantidad_paginas;
+    altura_ = cabecera.altura;
+    cantidad_registros_ = cabecera.cantidad_registros;
+    bytes_datos_ = cabecera.bytes_datos;
+}
+
+/**
+ * @brief Escribe lo pendiente; un destructor no debe lanzar.
+ */
+ArbolBMasDisco::~ArbolBMasDisco() {
+    try { vaciar(); }
+    catch (...) {}
+}
+
+// ---------- Pool de búferes ----------
+
+/**
+ * @brief Busca la página en el pool o la carga en el marco menos usado.
+ * @param numero Página a fijar.
+ * @return Índice del marco.
+ */
+size_t ArbolBMasDisco::fijar(uint32_t numero) {
+    auto encontrada = tabla_paginas_.find(numero);
+    if (encontrada != tabla_paginas_.end()) {
+        Marco& marco = marcos_[encontrada->second];
+        ++aciertos_;
+        ++marco.fijaciones;
+        orden_lru_.splice(orden_lru_.begin(), orden_lru_, marco.lru);
+        return encontrada->second;
+    }
+
+    const size_t indice = desalojar();
+    Marco& marco = marcos_[indice];
+    leer_pagina(numero, marco.pagina);
+    ++lecturas_;
+    marco.numero = numero;
+    marco.fijaciones = 1;
+    tabla_paginas_.emplace(numero, indice);
+    orden_lru_.splice(orden_lru_.begin(), orden_lru_, marco.lru);
+    return indice;
+}
+
+/**
+ * @brief Resta una fijación.
+ * @param marco Índice del marco.
+ */
+void ArbolBMasDisco::soltar(size_t marco) { --marcos_[marco].fijaciones; }
+
+/**
+ * @brief Recorre los marcos desde el menos usado y libera el primero sin fijar.
+ * @return Índice del marco libre.
+ * @details
+ * Si la página desalojada está sucia se escribe antes; si la escritura
+ * falla, el marco queda como estaba.
+ */
+size_t ArbolBMasDisco::desalojar() {
+    for (auto posicion = orden_lru_.rbegin(); posicion != orden_lru_.rend(); ++posicion) {
+        Marco& marco = marcos_[*posicion];
+        if (marco.fijaciones > 0) continue;
+        if (marco.numero != 0) {
+            if (marco.sucia) escribir_pagina(marco.numero, marco.pagina);
+            tabla_paginas_.erase(marco.numero);
+        }
+        marco.numero = 0;
+        marco.sucia = false;
+        return *posicion;
+    }
+    throw runtime_error("ArbolBMasDisco: todas las páginas del pool están fijadas");
+}
+
+/**
+ * @brief Asigna una página nueva en el pool, en ceros y marcada como sucia.
+ * @return Número de la página.
+ * @details
+ * No se escribe hasta que se desaloje o se llame a vaciar(); el archivo
+ * crece en ese momento.
+ */
+uint32_t ArbolBMasDisco::nueva_pagina() {
+    const size_t indice = desalojar();
+    Marco& marco = marcos_[indice];
+    memset(marco.pagina.bytes, 0, TAMANO_PAGINA);
+    marco.numero = cantidad_paginas_++;
+    marco.sucia = true;
+    tabla_paginas_.emplace(marco.numero, indice);
+    orden_lru_.splice(orden_lru_.begin(), orden_lru_, marco.lru);
+    return marco.numero;
+}
+
+/**
+ * @brief Lee una página completa.
+ * @param numero Número de página.
+ * @param pagina Destino.
+ * @throws std::runtime_error si la página no existe o falla la lectura.
+ */
+void ArbolBMasDisco::leer_pagina(uint32_t numero, Pagina& pagina) {
+    indice_.seekg(static_cast<streamoff>(numero) * static_cast<streamoff>(TAMANO_PAGINA));
+    indice_.read(reinterpret_cast<char*>(pagina.bytes), TAMANO_PAGINA);
+    if (!indice_) {
+        indice_.clear();
+        throw runtime_error("ArbolBMasDisco: no se pudo leer la página " + to_string(numero));
+    }
+}
+
+/**
+ * @brief Escribe una página completa.
+ * @param numero Número de página.
+ * @param pagina Contenido.
+ * @throws std::runtime_error si falla la escritura.
+ */
+void ArbolBMasDisco::escribir_pagina(uint32_t numero, const Pagina& pagina) {
+    indice_.seekp(static_cast<streamoff>(numero) * static_cast<streamoff>(TAMANO_PAGINA));
+    indice_.write(reinterpret_cast<const char*>(pagina.bytes), TAMANO_PAGINA);
+    if (!indice_) {
+        indice_.clear();
+        throw runtime_error("ArbolBMasDisco: no se pudo escribir la página " + to_string(numero));
+    }
+    ++escrituras_;
+}
+
+/**
+ * @brief Guarda el estado del árbol en la página 0.
+ */
+void ArbolBMasDisco::escribir_cabecera() {
+    Pagina pagina;
+    memset(pagina.bytes, 0, TAMANO_PAGINA);
+    const CabeceraArchivo cabecera = { MAGIA_INDICE, VERSION_INDICE, static_cast<uint32_t>(TAMANO_PAGINA), raiz_,
+        cantidad_paginas_, altura_, cantidad_registros_, bytes_datos_ };
+    memcpy(pagina.bytes, &cabecera, sizeof(cabecera));
+    escribir_pagina(0, pagina);
+}
+
+// ---------- Registros de datos ----------
+
+/**
+ * @brief Agrega el registro del estudiante al final de ruta.dat.
+ * @param estudiante Estudiante a guardar.
+ * @return Posición donde quedó el registro.
+ * @details
+ * Formato: id (int32), promedio (double), largo del nombre (uint16),
+ * nombre, largo de la carrera (uint16), carrera.
+ */
+uint64_t ArbolBMasDisco::escribir_registro(const Estudiante& estudiante) {
+    const string& nombre = estudiante.nombre();
+    const string& carrera = estudiante.carrera();
+    if (nombre.size() > 0xFFFF || carrera.size() > 0xFFFF) {
+        throw length_error("ArbolBMasDisco: cadena demasiado larga para el registro");
+    }
+
+    const int32_t id = estudiante.id();
+    const double promedio = estudiante.promedio();
+    const uint16_t largo_nombre = static_cast<uint16_t>(nombre.size());
+    const uint16_t largo_carrera = static_cast<uint16_t>(carrera.size());
+    registro_.clear();
+    registro_.append(reinterpret_cast<const char*>(&id), sizeof(id));
+    registro_.append(reinterpret_cast<const char*>(&promedio), sizeof(promedio));
+    registro_.append(reinterpret_cast<const char*>(&largo_nombre), sizeof(largo_nombre));
+    registro_.append(nombre);
+    registro_.append(reinterpret_cast<const char*>(&largo_carrera), sizeof(largo_carrera));
+    registro_.append(carrera);
+
+    const uint64_t posicion = bytes_datos_;
+    datos_.seekp(static_cast<streamoff>(posicion));
+    datos_.write(registro_.data(), static_cast<streamsize>(registro_.size()));
+    if (!datos_) {
+        datos_.clear();
+        throw runtime_error("ArbolBMasDisco: no se pudo escribir el registro");
+    }
+    bytes_datos_ += registro_.size();
+    return posicion;
+}
+
+/**
+ * @brief Lee un registro de ruta.dat.
+ * @param posicion Posición devuelta por escribir_registro().
+ * @return Estudiante reconstruido.
+ * @throws std::runtime_error si el registro está incompleto.
+ */
+Estudiante ArbolBMasDisco::leer_registro(uint64_t posicion) {
+    int32_t id;
+    double promedio;
+    uint16_t largo;
+    string nombre;
+
+    datos_.seekg(static_cast<streamoff>(posicion));
+    datos_.read(reinterpret_cast<char*>(&id), sizeof(id));
+    datos_.read(reinterpret_cast<char*>(&promedio), sizeof(promedio));
+    datos_.read(reinterpret_cast<char*>(&largo), sizeof(largo));
+    nombre.resize(largo);
+    datos_.read(nombre.data(), largo);
+    datos_.read(reinterpret_cast<char*>(&largo), sizeof(largo));
+    registro_.resize(largo);
+    datos_.read(registro_.data(), largo);
+    if (!datos_) {
+        datos_.clear();
+        throw runtime_error("ArbolBMasDisco: registro incompleto en la posición " + to_string(posicion));
+    }
+    return Estudiante(id, std::move(nombre), registro_, promedio);
+}
+
+// ---------- Búsqueda dentro de una página ----------
+
+/**
+ * @brief Compara dos claves compuestas.
+ * @return Negativo si (g1, id1) < (g2, id2), 0 si son iguales, positivo si es mayor.
+ */
+int ArbolBMasDisco::comparar_claves(int g1, int id1, int g2, int id2) {
+    if (g1 != g2) return g1 < g2 ? -1 : 1;
+    if (id1 != id2) return id1 < id2 ? -1 : 1;
+    return 0;
+}
+
+/**
+ * @brief Búsqueda binaria de la cota inferior (o superior) en una hoja.
+ */
+size_t ArbolBMasDisco::posicion_en_hoja(const Pagina& pagina, int clave_promedio_cent, int id, bool estricta) {
+    size_t inicio = 0, fin = pagina.hoja.cabecera.cantidad;
+    while (inicio < fin) {
+        const size_t medio = (inicio + fin) / 2;
+        const EntradaHoja& entrada = pagina.hoja.entradas[medio];
+        const int comparacion = comparar_claves(entrada.clave_promedio_cent, entrada.id, clave_promedio_cent, id);
+        if (comparacion < 0 || (estricta && comparacion == 0)) inicio = medio + 1;
+        else fin = medio;
+    }
+    return inicio;
+}
+
+/**
+ * @brief Último separador menor o igual que la clave.
+ * @return Su índice, o -1 si la clave es menor que todos.
+ */
+int ArbolBMasDisco::hijo_en_interno(const Pagina& pagina, int clave_promedio_cent, int id) {
+    size_t inicio = 0, fin = pagina.interno.cabecera.cantidad;
+    while (inicio < fin) {
+        const size_t medio = (inicio + fin) / 2;
+        const EntradaInterna& entrada = pagina.interno.entradas[medio];
+        if (comparar_claves(entrada.clave_promedio_cent, entrada.id, clave_promedio_cent, id) <= 0) inicio = medio + 1;
+        else fin = medio;
+    }
+    return static_cast<int>(inicio) - 1;
+}
+
+// ---------- Inserción ----------
+
+/**
+ * @brief Inserta en el subárbol de la página indicada.
+ * @details
+ * Baja hasta la hoja manteniendo fijados los ancestros, que son los únicos
+ * que pueden recibir un separador nuevo. Las divisiones se arman en un
+ * arreglo temporal con una entrada de más y se reparten entre la página
+ * original y la nueva.
+ */
+bool ArbolBMasDisco::insertar_recursivo(uint32_t numero, const EntradaHoja& entrada, bool extremo_derecho, Division& division, bool& nueva) {
+    PaginaFijada fijada(*this, numero);
+    Pagina& pagina = fijada.pagina();
+
+    if (pagina.hoja.cabecera.tipo == TIPO_HOJA) {
+        auto& hoja = pagina.hoja;
+        const size_t cantidad = hoja.cabecera.cantidad;
+        const size_t posicion = posicion_en_hoja(pagina, entrada.clave_promedio_cent, entrada.id, false);
+        fijada.marcar_sucia();
+        if (posicion < cantidad && hoja.entradas[posicion].clave_promedio_cent == entrada.clave_promedio_cent && hoja.entradas[posicion].id == entrada.id) {
+            hoja.entradas[posicion].posicion = entrada.posicion;
+            nueva = false;
+            return false;
+        }
+        nueva = true;
+
+        if (cantidad < MAXIMO_HOJA) {
+            memmove(&hoja.entradas[posicion + 1], &hoja.entradas[posicion], (cantidad - posicion) * sizeof(EntradaHoja));
+            hoja.entradas[posicion] = entrada;
+            ++hoja.cabecera.cantidad;
+            return false;
+        }
+
+        EntradaHoja combinadas[MAXIMO_HOJA + 1];
+        memcpy(combinadas, hoja.entradas, posicion * sizeof(EntradaHoja));
+        combinadas[posicion] = entrada;
+        memcpy(&combinadas[posicion + 1], &hoja.entradas[posicion], (cantidad - posicion) * sizeof(EntradaHoja));
+        const size_t total = cantidad + 1;
+        const size_t quedan = (posicion == cantidad && hoja.cabecera.enlace0 == 0) ? cantidad : total / 2;
+
+        const uint32_t numero_nueva = nueva_pagina();
+        PaginaFijada fijada_nueva(*this, numero_nueva);
+        auto& derecha = fijada_nueva.pagina().hoja;
+        derecha.cabecera.tipo = TIPO_HOJA;
+        derecha.cabecera.cantidad = static_cast<uint16_t>(total - quedan);
+        memcpy(derecha.entradas, &combinadas[quedan], (total - quedan) * sizeof(EntradaHoja));
+        memcpy(hoja.entradas, combinadas, quedan * sizeof(EntradaHoja));
+        hoja.cabecera.cantidad = static_cast<uint16_t>(quedan);
+
+        derecha.cabecera.enlace0 = hoja.cabecera.enlace0;
+        derecha.cabecera.enlace1 = numero;
+        if (hoja.cabecera.enlace0 != 0) {
+            PaginaFijada siguiente(*this, hoja.cabecera.enlace0);
+            siguiente.pagina().hoja.cabecera.enlace1 = numero_nueva;
+            siguiente.marcar_sucia();
+        }
+        hoja.cabecera.enlace0 = numero_nueva;
+
+        division = { derecha.entradas[0].clave_promedio_cent, derecha.entradas[0].id, numero_nueva };
+        return true;
+    }
+
+    auto& interno = pagina.interno;
+    const int indice = hijo_en_interno(pagina, entrada.clave_promedio_cent, entrada.id);
+    const uint32_t hijo = indice < 0 ? interno.cabecera.enlace0 : interno.entradas[indice].hijo;
+    const bool hijo_extremo = extremo_derecho && indice == static_cast<int>(interno.cabecera.cantidad) - 1;
+    Division del_hijo;
+    if (!insertar_recursivo(hijo, entrada, hijo_extremo, del_hijo, nueva)) return false;
+
+    fijada.marcar_sucia();
+    const size_t cantidad = interno.cabecera.cantidad;
+    const size_t posicion = static_cast<size_t>(indice + 1);
+    const EntradaInterna separador = { del_hijo.clave_promedio_cent, del_hijo.id, del_hijo.pagina };
+    if (cantidad < MAXIMO_INTERNO) {
+        memmove(&interno.entradas[posicion + 1], &interno.entradas[posicion], (cantidad - posicion) * sizeof(EntradaInterna));
+        interno.entradas[posicion] = separador;
+        ++interno.cabecera.cantidad;
+        return false;
+    }
+
+    EntradaInterna combinadas[MAXIMO_INTERNO + 1];
+    memcpy(combinadas, interno.entradas, posicion * sizeof(EntradaInterna));
+    combinadas[posicion] = separador;
+    memcpy(&combinadas[posicion + 1], &interno.entradas[posicion], (cantidad - posicion) * sizeof(EntradaInterna));
+    const size_t total = cantidad + 1;
+    // El separador en "medio" sube al padre; su hijo pasa a ser el enlace0 de la página nueva.
+    const size_t medio = (extremo_derecho && posicion == cantidad) ? cantidad : total / 2;
+
+    const uint32_t numero_nueva = nueva_pagina();
+    PaginaFijada fijada_nueva(*this, numero_nueva);
+    auto& derecha = fijada_nueva.pagina().interno;
+    derecha.cabecera.tipo = TIPO_INTERNO;
+    derecha.cabecera.enlace0 = combinadas[medio].hijo;
+    derecha.cabecera.cantidad = static_cast<uint16_t>(total - medio - 1);
+    memcpy(derecha.entradas, &combinadas[medio + 1], (total - medio - 1) * sizeof(EntradaInterna));
+    memcpy(interno.entradas, combinadas, medio * sizeof(EntradaInterna));
+    interno.cabecera.cantidad = static_cast<uint16_t>(medio);
+
+    division = { combinadas[medio].clave_promedio_cent, combinadas[medio].id, numero_nueva };
+    return true;
+}
+
+/**
+ * @brief Inserta o reemplaza un estudiante.
+ * @param estudiante Estudiante a guardar.
+ * @details
+ * El registro se agrega a ruta.dat y la hoja apunta a él. Si la raíz se
+ * divide, se crea una raíz interna nueva con los dos lados.
+ */
+void ArbolBMasDisco::insertar(const Estudiante& estudiante) {
+    const EntradaHoja entrada = { convertir_promedio_a_clave(estudiante.promedio()), estudiante.id(), escribir_registro(estudiante) };
+    Division division;
+    bool nueva = false;
+    if (insertar_recursivo(raiz_, entrada, true, division, nueva)) {
+        const uint32_t numero = nueva_pagina();
+        PaginaFijada fijada(*this, numero);
+        auto& interno = fijada.pagina().interno;
+        interno.cabecera.tipo = TIPO_INTERNO;
+        interno.cabecera.cantidad = 1;
+        interno.cabecera.enlace0 = raiz_;
+        interno.entradas[0] = { division.clave_promedio_cent, division.id, division.pagina };
+        raiz_ = numero;
+        ++altura_;
+    }
+    if (nueva) ++cantidad_registros_;
+}
+
+/**
+ * @brief Copia un árbol en memoria con un recorrido inorden.
+ * @param arbol Árbol de origen.
+ * @details
+ * Las claves llegan ordenadas, así que cada inserción cae al final de la
+ * última hoja y las páginas quedan llenas.
+ */
+void ArbolBMasDisco::cargar_desde(const ArbolBinarioBusqueda& arbol) {
+    arbol.inorden_it([this](const Estudiante& estudiante) { insertar(estudiante); });
+}
+
+// ---------- Recorridos ----------
+
+/**
+ * @brief Desciende hasta la hoja donde estaría la clave.
+ * @return Número de la hoja.
+ */
+uint32_t ArbolBMasDisco::buscar_hoja(int clave_promedio_cent, int id) {
+    uint32_t numero = raiz_;
+    while (true) {
+        PaginaFijada fijada(*this, numero);
+        const Pagina& pagina = fijada.pagina();
+        if (pagina.hoja.cabecera.tipo == TIPO_HOJA) return numero;
+        const int indice = hijo_en_interno(pagina, clave_promedio_cent, id);
+        numero = indice < 0 ? pagina.interno.cabecera.enlace0 : pagina.interno.entradas[indice].hijo;
+    }
+}
+
+/**
+ * @brief Primera o última hoja del árbol.
+ * @param derecha true para la última.
+ * @return Número de la hoja.
+ */
+uint32_t ArbolBMasDisco::hoja_extrema(bool derecha) {
+    uint32_t numero = raiz_;
+    while (true) {
+        PaginaFijada fijada(*this, numero);
+        const Pagina& pagina = fijada.pagina();
+        if (pagina.hoja.cabecera.tipo == TIPO_HOJA) return numero;
+        const auto& interno = pagina.interno;
+        numero = (derecha && interno.cabecera.cantidad > 0) ? interno.entradas[interno.cabecera.cantidad - 1].hijo : interno.cabecera.enlace0;
+    }
+}
+
+/**
+ * @brief Recorre las entradas de hoja en orden a partir de una clave.
+ * @details
+ * Baja una vez hasta la hoja y luego sigue la lista enlazada de hojas; cada
+ * hoja se fija solo mientras se visitan sus entradas.
+ */
+void ArbolBMasDisco::recorrer_desde(int clave_promedio_cent, int id, bool estricta, const function<bool(const EntradaHoja&)>& visitar) {
+    uint32_t numero = buscar_hoja(clave_promedio_cent, id);
+    bool primera = true;
+    while (numero != 0) {
+        PaginaFijada fijada(*this, numero);
+        const Pagina& pagina = fijada.pagina();
+        const size_t inicio = primera ? posicion_en_hoja(pagina, clave_promedio_cent, id, estricta) : 0;
+        primera = false;
+        for (size_t indice = inicio; indice < pagina.hoja.cabecera.cantidad; ++indice) {
+            if (!visitar(pagina.hoja.entradas[indice])) return;
+        }
+        numero = pagina.hoja.cabecera.enlace0;
+    }
+}
+
+/**
+ * @brief Busca el primer estudiante con el promedio exacto.
+ * @param promedio Promedio buscado.
+ * @return Estudiante encontrado o vacío.
+ */
+optional<Estudiante> ArbolBMasDisco::buscar_por_promedio(double promedio) {
+    const int clave = convertir_promedio_a_clave(promedio);
+    optional<Estudiante> resultado;
+    uint64_t posicion = 0;
+    bool encontrado = false;
+    recorrer_desde(clave, INT_MIN, false, [&](const EntradaHoja& entrada) {
+        encontrado = entrada.clave_promedio_cent == clave;
+        posicion = entrada.posicion;
+        return false;
+        });
+    if (encontrado) resultado = leer_registro(posicion);
+    return resultado;
+}
+
+/**
+ * @brief Busca por ID recorriendo las hojas.
+ * @param id ID buscado.
+ * @return Estudiante encontrado o vacío.
+ */
+optional<Estudiante> ArbolBMasDisco::buscar_por_id(int id) {
+    optional<Estudiante> resultado;
+    uint32_t numero = hoja_extrema(false);
+    while (numero != 0) {
+        PaginaFijada fijada(*this, numero);
+        const auto& hoja = fijada.pagina().hoja;
+        for (size_t indice = 0; indice < hoja.cabecera.cantidad; ++indice) {
+            if (hoja.entradas[indice].id == id) {
+                resultado = leer_registro(hoja.entradas[indice].posicion);
+                return resultado;
+            }
+        }
+        numero = hoja.cabecera.enlace0;
+    }
+    return resultado;
+}
+
+/**
+ * @brief Visita los estudiantes de un rango de promedios.
+ * @param minimo Promedio mínimo.
+ * @param maximo Promedio máximo.
+ * @param visitar Función callback para cada estudiante.
+ */
+void ArbolBMasDisco::rango(double minimo, double maximo, const function<void(const Estudiante&)>& visitar) {
+    const int clave_minima = convertir_promedio_a_clave(minimo);
+    const int clave_maxima = convertir_promedio_a_clave(maximo);
+    if (clave_minima > clave_maxima) return;
+    recorrer_desde(clave_minima, INT_MIN, false, [&](const EntradaHoja& entrada) {
+        if (entrada.clave_promedio_cent > clave_maxima) return false;
+        visitar(leer_registro(entrada.posicion));
+        return true;
+        });
+}
+
+/**
+ * @brief Estadísticas de un rango calculadas con las claves de las hojas.
+ * @param minimo Promedio mínimo.
+ * @param maximo Promedio máximo.
+ * @return Cantidad, media y varianza (misma escala que ArbolBinarioBusqueda).
+ */
+EstadisticasRango ArbolBMasDisco::estadisticas_rango(double minimo, double maximo) {
+    EstadisticasRango resultado;
+    const int clave_minima = convertir_promedio_a_clave(minimo);
+    const int clave_maxima = convertir_promedio_a_clave(maximo);
+    if (clave_minima > clave_maxima) return resultado;
+
+    long long cantidad = 0, suma = 0, cuadrados = 0;
+    recorrer_desde(clave_minima, INT_MIN, false, [&](const EntradaHoja& entrada) {
+        if (entrada.clave_promedio_cent > clave_maxima) return false;
+        ++cantidad;
+        suma += entrada.clave_promedio_cent;
+        cuadrados += static_cast<long long>(entrada.clave_promedio_cent) * entrada.clave_promedio_cent;
+        return true;
+        });
+    if (cantidad == 0) return resultado;
+
+    const double media_cent = static_cast<double>(suma) / cantidad;
+    const double varianza_cent = static_cast<double>(cuadrados) / cantidad - media_cent * media_cent;
+    resultado.cantidad = static_cast<int>(cantidad);
+    resultado.media = media_cent / 100.0;
+    resultado.varianza = std::max(0.0, varianza_cent) / 10000.0;
+    return resultado;
+}
+
+/**
+ * @brief Recorre todos los estudiantes en orden ascendente.
+ * @param visitar Función callback para cada estudiante.
+ */
+void ArbolBMasDisco::inorden(const function<void(const Estudiante&)>& visitar) {
+    recorrer_desde(INT_MIN, INT_MIN, false, [&](const EntradaHoja& entrada) {
+        visitar(leer_registro(entrada.posicion));
+        return true;
+        });
+}
+
+/**
+ * @brief Visita los k mayores promedios siguiendo las hojas hacia atrás.
+ * @param k Cantidad de estudiantes.
+ * @param visitar Función callback para cada estudiante.
+ */
+void ArbolBMasDisco::top_k(int k, const function<void(const Estudiante&)>& visitar) {
+    int visitados = 0;
+    uint32_t numero = hoja_extrema(true);
+    while (numero != 0 && visitados < k) {
+        PaginaFijada fijada(*this, numero);
+        const auto& hoja = fijada.pagina().hoja;
+        for (size_t indice = hoja.cabecera.cantidad; indice > 0 && visitados < k; --indice, ++visitados) {
+            visitar(leer_registro(hoja.entradas[indice - 1].posicion));
+        }
+        numero = hoja.cabecera.enlace1;
+    }
+}
+
+/**
+ * @brief Visita los k menores promedios.
+ * @param k Cantidad de estudiantes.
+ * @param visitar Función callback para cada estudiante.
+ */
+void ArbolBMasDisco::bottom_k(int k, const function<void(const Estudiante&)>& visitar) {
+    if (k <= 0) return;
+    int visitados = 0;
+    recorrer_desde(INT_MIN, INT_MIN, false, [&](const EntradaHoja& entrada) {
+        visitar(leer_registro(entrada.posicion));
+        return ++visitados < k;
+        });
+}
+
+/**
+ * @brief Visita la página que sigue al cursor.
+ * @param cursor Última clave entregada.
+ * @param n Tamaño de la página.
+ * @param visitar Función callback para cada estudiante.
+ * @return Cursor con la clave del último estudiante visitado.
+ */
+CursorPagina ArbolBMasDisco::siguiente_pagina(const CursorPagina& cursor, int n, const function<void(const Estudiante&)>& visitar) {
+    CursorPagina siguiente = cursor;
+    if (n <= 0) return siguiente;
+    int visitados = 0;
+    auto visitar_entrada = [&](const EntradaHoja& entrada) {
+        visitar(leer_registro(entrada.posicion));
+        siguiente.al_inicio = false;
+        siguiente.clave_promedio_cent = entrada.clave_promedio_cent;
+        siguiente.id = entrada.id;
+        return ++visitados < n;
+        };
+    if (cursor.al_inicio) recorrer_desde(INT_MIN, INT_MIN, false, visitar_entrada);
+    else recorrer_desde(cursor.clave_promedio_cent, cursor.id, true, visitar_entrada);
+    return siguiente;
+}
+
+// ---------- Métricas y mantenimiento ----------
+
+/**
+ * @brief Niveles del árbol.
+ * @return 0 si está vacío.
+ */
+int ArbolBMasDisco::altura() const { return cantidad_registros_ == 0 ? 0 : static_cast<int>(altura_); }
+
+/**
+ * @brief Cantidad de estudiantes.
+ * @return Registros indexados.
+ */
+uint64_t ArbolBMasDisco::contar_registros() const { return cantidad_registros_; }
+
+/**
+ * @brief Indica si no hay estudiantes.
+ * @return true si está vacío.
+ */
+bool ArbolBMasDisco::vacio() const { return cantidad_registros_ == 0; }
+
+/**
+ * @brief Escribe las páginas sucias y la cabecera.
+ * @throws std::runtime_error si falla la escritura.
+ */
+void ArbolBMasDisco::vaciar() {
+    for (Marco& marco : marcos_) {
+        if (marco.numero != 0 && marco.sucia) {
+            escribir_pagina(marco.numero, marco.pagina);
+            marco.sucia = false;
+        }
+    }
+    escribir_cabecera();
+    indice_.flush();
+    datos_.flush();
+    if (!indice_ || !datos_) throw runtime_error("ArbolBMasDisco: no se pudieron vaciar los archivos");
+}
+
+/**
+ * @brief Páginas servidas desde el pool.
+ */
+uint64_t ArbolBMasDisco::aciertos_cache() const { return aciertos_; }
+
+/**
+ * @brief Páginas leídas del disco.
+ */
+uint64_t ArbolBMasDisco::lecturas_disco() const { return lecturas_; }
+
+/**
+ * @brief Páginas escritas al disco.
+ */
+uint64_t ArbolBMasDisco::escrituras_disco() const { return escrituras_; }
@@ -0,0 +1,421 @@
+#pragma once
+#include "ArbolBinarioBusqueda.h"
+#include "Estudiante.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Árbol B+ en disco para listas de estudiantes que no caben en memoria.
+ * @details
+ * Usa la misma clave que ArbolBinarioBusqueda (promedio en centésimas y, en
+ * caso de empate, ID) y ofrece sus consultas de búsqueda, rango y recorrido,
+ * pero los nodos viven en un archivo de páginas de tamaño fijo y en memoria
+ * solo se conserva un grupo acotado de páginas (pool de búferes con
+ * reemplazo LRU). Las páginas consultadas seguido quedan en caché; las demás
+ * se leen del disco cuando se necesitan.
+ *
+ * Se usan dos archivos a partir de una ruta base:
+ * - ruta.idx: páginas de TAMANO_PAGINA bytes. La 0 es la cabecera; las
+ *   hojas guardan (clave, ID, posición del registro) y están enlazadas en
+ *   ambos sentidos; los internos guardan separadores e hijos.
+ * - ruta.dat: montículo de registros (id, promedio, nombre, carrera) al que
+ *   apuntan las hojas. Solo se agregan registros; una actualización escribe
+ *   uno nuevo y deja el anterior sin referencia.
+ *
+ * Los archivos usan el orden de bytes de la máquina: sirven como
+ * almacenamiento local, no como formato de intercambio. Al abrir una ruta
+ * existente se retoma el árbol guardado; los cambios llegan al disco al
+ * desalojar páginas, con vaciar() y en el destructor.
+ *
+ * Como ArbolBinarioBusqueda, no tiene eliminación y no es seguro para
+ * usarse desde varios hilos a la vez.
+ */
+class ArbolBMasDisco {
+public:
+    /**
+     * @brief Tamaño en bytes de cada página del archivo de índice.
+     */
+    static constexpr std::size_t TAMANO_PAGINA = 4096;
+
+private:
+    /**
+     * @brief Cabecera común de las páginas de nodos (16 bytes).
+     */
+    struct CabeceraNodo {
+        std::uint16_t tipo;       ///< TIPO_HOJA o TIPO_INTERNO
+        std::uint16_t cantidad;   ///< entradas en uso
+        std::uint32_t enlace0;    ///< hoja: página siguiente; interno: hijo izquierdo de todo
+        std::uint32_t enlace1;    ///< hoja: página anterior; interno: sin uso
+        std::uint32_t reservado;
+    };
+
+    /**
+     * @brief Entrada de hoja: clave del estudiante y posición de su registro en ruta.dat.
+     */
+    struct EntradaHoja {
+        std::int32_t clave_promedio_cent;
+        std::int32_t id;
+        std::uint64_t posicion;
+    };
+
+    /**
+     * @brief Entrada de nodo interno: separador y el hijo con las claves mayores o iguales.
+     */
+    struct EntradaInterna {
+        std::int32_t clave_promedio_cent;
+        std::int32_t id;
+        std::uint32_t hijo;
+    };
+
+    /**
+     * @brief Entradas que caben en una hoja.
+     */
+    static constexpr std::size_t MAXIMO_HOJA = (TAMANO_PAGINA - sizeof(CabeceraNodo)) / sizeof(EntradaHoja);
+
+    /**
+     * @brief Separadores que caben en un nodo interno.
+     */
+    static constexpr std::size_t MAXIMO_INTERNO = (TAMANO_PAGINA - sizeof(CabeceraNodo)) / sizeof(EntradaInterna);
+
+    /**
+     * @brief Contenido de una página en memoria.
+     * @details
+     * La E/S se hace sobre los bytes de la página completa; el árbol accede
+     * siempre por el miembro que corresponde a su tipo.
+     */
+    union Pagina {
+        struct {
+            CabeceraNodo cabecera;
+            EntradaHoja entradas[MAXIMO_HOJA];
+        } hoja;
+        struct {
+            CabeceraNodo cabecera;
+            EntradaInterna entradas[MAXIMO_INTERNO];
+        } interno;
+        unsigned char bytes[TAMANO_PAGINA];
+    };
+
+    /**
+     * @brief Marco del pool de búferes: una página cargada y su estado.
+     */
+    struct Marco {
+        std::uint32_t numero = 0;               ///< página cargada (0 = libre; la 0 nunca se carga)
+        int fijaciones = 0;                     ///< usos activos; con fijaciones no se desaloja
+        bool sucia = false;                     ///< modificada desde que se leyó
+        std::list<std::size_t>::iterator lru;   ///< posición en orden_lru_
+        Pagina pagina;
+    };
+
+    /**
+     * @brief Fija una página mientras está en alcance y la suelta al destruirse.
+     * @details
+     * Mientras exista, el marco no se desaloja, así que el puntero a la
+     * página sigue siendo válido aunque se carguen otras.
+     */
+    class PaginaFijada {
+    private:
+        ArbolBMasDisco* arbol_;
+        std::size_t marco_;
+
+    public:
+        PaginaFijada(ArbolBMasDisco& arbol, std::uint32_t numero);
+        ~PaginaFijada();
+        PaginaFijada(const PaginaFijada&) = delete;
+        PaginaFijada& operator=(const PaginaFijada&) = delete;
+
+        /**
+         * @brief Página fijada.
+         */
+        Pagina& pagina() const;
+
+        /**
+         * @brief Marca la página como modificada para escribirla al desalojarla.
+         */
+        void marcar_sucia() const;
+    };
+
+    /**
+     * @brief Separador y página nueva que un hijo devuelve al dividirse.
+     */
+    struct Division {
+        std::int32_t clave_promedio_cent;
+        std::int32_t id;
+        std::uint32_t pagina;
+    };
+
+    std::fstream indice_;   ///< archivo de páginas (ruta.idx)
+    std::fstream datos_;    ///< montículo de registros (ruta.dat)
+
+    std::uint32_t raiz_;                  ///< página raíz
+    std::uint32_t cantidad_paginas_;      ///< páginas asignadas, contando la cabecera
+    std::uint32_t altura_;                ///< niveles (1 = la raíz es hoja)
+    std::uint64_t cantidad_registros_;    ///< estudiantes indexados
+    std::uint64_t bytes_datos_;           ///< tamaño lógico de ruta.dat
+
+    /**
+     * @brief Marcos del pool; su cantidad se fija al construir y no cambia.
+     */
+    std::vector<Marco> marcos_;
+
+    /**
+     * @brief Página cargada -> índice de marco.
+     */
+    std::unordered_map<std::uint32_t, std::size_t> tabla_paginas_;
+
+    /**
+     * @brief Marcos del más recientemente usado (frente) al menos usado (final).
+     */
+    std::list<std::size_t> orden_lru_;
+
+    std::uint64_t aciertos_;   ///< páginas encontradas en el pool
+    std::uint64_t lecturas_;   ///< páginas leídas del disco
+    std::uint64_t escrituras_; ///< páginas escritas al disco
+
+    /**
+     * @brief Búfer reutilizado para leer registros de ruta.dat.
+     */
+    std::string registro_;
+
+    /**
+     * @brief Compara dos claves (promedio_cent, id).
+     * @return Negativo, cero o positivo.
+     */
+    static int comparar_claves(int g1, int id1, int g2, int id2);
+
+    /**
+     * @brief Primera posición de la hoja cuya clave es mayor o igual (o estrictamente mayor) que la dada.
+     * @param pagina Hoja a revisar.
+     * @param clave_promedio_cent Clave de promedio.
+     * @param id ID de desempate.
+     * @param estricta true para la primera clave estrictamente mayor.
+     * @return Índice entre 0 y la cantidad de entradas.
+     */
+    static std::size_t posicion_en_hoja(const Pagina& pagina, int clave_promedio_cent, int id, bool estricta);
+
+    /**
+     * @brief Hijo de un nodo interno por el que se baja a buscar la clave.
+     * @param pagina Nodo interno.
+     * @param clave_promedio_cent Clave de promedio.
+     * @param id ID de desempate.
+     * @return Índice de entrada cuyo hijo se sigue, o -1 para enlace0.
+     */
+    static int hijo_en_interno(const Pagina& pagina, int clave_promedio_cent, int id);
+
+    /**
+     * @brief Fija una página, cargándola del disco si no está en el pool.
+     * @param numero Número de página.
+     * @return Índice del marco.
+     * @throws std::runtime_error si todos los marcos están fijados o falla la E/S.
+     */
+    std::size_t fijar(std::uint32_t numero);
+
+    /**
+     * @brief Libera una fijación de un marco.
+     * @param marco Índice del marco.
+     */
+    void soltar(std::size_t marco);
+
+    /**
+     * @brief Libera el marco menos usado que no esté fijado.
+     * @return Índice del marco, ya fuera de la tabla de páginas.
+     * @throws std::runtime_error si todos están fijados.
+     */
+    std::size_t desalojar();
+
+    /**
+     * @brief Asigna una página nueva al final del archivo, vacía y ya en el pool.
+     * @return Número de la página.
+     */
+    std::uint32_t nueva_pagina();
+
+    /**
+     * @brief Lee una página del archivo de índice.
+     */
+    void leer_pagina(std::uint32_t numero, Pagina& pagina);
+
+    /**
+     * @brief Escribe una página al archivo de índice.
+     */
+    void escribir_pagina(std::uint32_t numero, const Pagina& pagina);
+
+    /**
+     * @brief Escribe la página 0 con el estado del árbol.
+     */
+    void escribir_cabecera();
+
+    /**
+     * @brief Agrega un registro al final de ruta.dat.
+     * @param estudiante Estudiante a guardar.
+     * @return Posición del registro.
+     * @throws std::length_error si el nombre o la carrera superan 65535 bytes.
+     */
+    std::uint64_t escribir_registro(const Estudiante& estudiante);
+
+    /**
+     * @brief Lee el registro de ruta.dat en la posición dada.
+     */
+    Estudiante leer_registro(std::uint64_t posicion);
+
+    /**
+     * @brief Inserta la entrada en el subárbol y devuelve la división, si la hubo.
+     * @param numero Página raíz del subárbol.
+     * @param entrada Entrada a insertar.
+     * @param extremo_derecho true si la página es la última de su nivel.
+     * @param division Se llena si la página se dividió.
+     * @param nueva true si la clave no existía.
+     * @return true si la página se dividió.
+     * @details
+     * Una página llena se parte por la mitad, salvo que la inserción caiga al
+     * final de la última página del nivel: entonces la página queda llena y
+     * la nueva empieza solo con lo agregado. Así una carga en orden (como
+     * cargar_desde()) deja las páginas completas en vez de a medias.
+     */
+    bool insertar_recursivo(std::uint32_t numero, const EntradaHoja& entrada, bool extremo_derecho, Division& division, bool& nueva);
+
+    /**
+     * @brief Baja hasta la hoja que contendría la clave.
+     * @return Número de la hoja.
+     */
+    std::uint32_t buscar_hoja(int clave_promedio_cent, int id);
+
+    /**
+     * @brief Hoja más a la izquierda o más a la derecha.
+     * @param derecha true para la última hoja.
+     */
+    std::uint32_t hoja_extrema(bool derecha);
+
+    /**
+     * @brief Recorre las hojas en orden ascendente desde la clave indicada.
+     * @param clave_promedio_cent Clave de inicio.
+     * @param id ID de inicio.
+     * @param estricta true para empezar en la primera clave estrictamente mayor.
+     * @param visitar Recibe cada entrada; devuelve false para detenerse.
+     */
+    void recorrer_desde(int clave_promedio_cent, int id, bool estricta, const std::function<bool(const EntradaHoja&)>& visitar);
+
+public:
+    /**
+     * @brief Abre (o crea) el árbol guardado en ruta.idx y ruta.dat.
+     * @param ruta_base Ruta sin extensión.
+     * @param paginas_en_memoria Tamaño del pool en páginas (mínimo 8).
+     * @throws std::runtime_error si no se pueden abrir los archivos o no
+     *         tienen el formato esperado.
+     */
+    explicit ArbolBMasDisco(const std::string& ruta_base, std::size_t paginas_en_memoria = 256);
+
+    /**
+     * @brief Escribe las páginas pendientes; ignora errores de E/S.
+     */
+    ~ArbolBMasDisco();
+
+    ArbolBMasDisco(const ArbolBMasDisco&) = delete;
+    ArbolBMasDisco& operator=(const ArbolBMasDisco&) = delete;
+
+    /**
+     * @brief Inserta un estudiante; si su clave ya existe, lo reemplaza.
+     * @param estudiante Estudiante a insertar.
+     */
+    void insertar(const Estudiante& estudiante);
+
+    /**
+     * @brief Inserta todos los estudiantes de un árbol en memoria, en orden.
+     * @param arbol Árbol de origen.
+     */
+    void cargar_desde(const ArbolBinarioBusqueda& arbol);
+
+    /**
+     * @brief Busca un estudiante con el promedio exacto.
+     * @param promedio Promedio (0.0 - 100.0).
+     * @return El de menor ID con ese promedio, o vacío si no hay.
+     */
+    std::optional<Estudiante> buscar_por_promedio(double promedio);
+
+    /**
+     * @brief Busca un estudiante por ID.
+     * @param id ID buscado.
+     * @return El estudiante, o vacío si no existe.
+     * @details
+     * El árbol no está ordenado por ID, así que recorre las hojas; el ID
+     * forma parte de la clave, por lo que solo lee ruta.dat al encontrarlo.
+     */
+    std::optional<Estudiante> buscar_por_id(int id);
+
+    /**
+     * @brief Visita los estudiantes con promedio dentro de [minimo, maximo], en orden.
+     * @param minimo Promedio mínimo.
+     * @param maximo Promedio máximo.
+     * @param visitar Función callback para cada estudiante.
+     */
+    void rango(double minimo, double maximo, const std::function<void(const Estudiante&)>& visitar);
+
+    /**
+     * @brief Cantidad, media y varianza de los promedios dentro de [minimo, maximo].
+     * @details
+     * Usa solo las claves de las hojas, sin leer ruta.dat.
+     */
+    EstadisticasRango estadisticas_rango(double minimo, double maximo);
+
+    /**
+     * @brief Recorre todos los estudiantes en orden ascendente.
+     * @param visitar Función callback para cada estudiante.
+     */
+    void inorden(const std::function<void(const Estudiante&)>& visitar);
+
+    /**
+     * @brief Visita los k estudiantes con mayor promedio, de mayor a menor.
+     */
+    void top_k(int k, const std::function<void(const Estudiante&)>& visitar);
+
+    /**
+     * @brief Visita los k estudiantes con menor promedio, de menor a mayor.
+     */
+    void bottom_k(int k, const std::function<void(const Estudiante&)>& visitar);
+
+    /**
+     * @brief Visita la página de hasta n estudiantes que sigue al cursor.
+     * @return Cursor para la página siguiente (mismo formato que ArbolBinarioBusqueda).
+     */
+    CursorPagina siguiente_pagina(const CursorPagina& cursor, int n, const std::function<void(const Estudiante&)>& visitar);
+
+    /**
+     * @brief Niveles del árbol (0 si está vacío).
+     */
+    int altura() const;
+
+    /**
+     * @brief Cantidad de estudiantes.
+     */
+    std::uint64_t contar_registros() const;
+
+    /**
+     * @brief Indica si el árbol está vacío.
+     */
+    bool vacio() const;
+
+    /**
+     * @brief Escribe las páginas modificadas y la cabecera, y vacía los archivos.
+     */
+    void vaciar();
+
+    /**
+     * @brief Páginas servidas desde el pool sin leer el disco.
+     */
+    std::uint64_t aciertos_cache() const;
+
+    /**
+     * @brief Páginas leídas del disco.
+     */
+    std::uint64_t lecturas_disco() const;
+
+    /**
+     * @brief Páginas escritas al disco.
+     */
+    std::uint64_t escrituras_disco() const;
+};
@@ -1,62 +1,271 @@
 #include "ArbolBinarioBusqueda.h"
+#include "DiccionarioCadenas.h"
 #include <stack>
 #include <queue>
 #include <algorithm>
+#include <climits>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <new>
+#include <optional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+#include <unordered_map>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#define ABB_PRECARGAR(direccion) _mm_prefetch(reinterpret_cast<const char*>(direccion), _MM_HINT_T0)
+#elif defined(__GNUC__)
+#define ABB_PRECARGAR(direccion) __builtin_prefetch(direccion)
+#else
+#define ABB_PRECARGAR(direccion) ((void)0)
+#endif
 
 using namespace std;
 
+// Instrumentación: con ABB_ESTADISTICAS la instrucción se compila; sin ella desaparece.
+#ifdef ABB_ESTADISTICAS
+#define ABB_REGISTRAR(instruccion) instruccion
+#else
+#define ABB_REGISTRAR(instruccion) ((void)0)
+#endif
+
+#ifdef ABB_ESTADISTICAS
+/**
+ * @brief Suma una búsqueda de la profundidad indicada al histograma.
+ * @param estadisticas Estadísticas del árbol a actualizar.
+ * @param profundidad Cantidad de nodos visitados por la búsqueda.
+ * @details
+ * Las profundidades mayores que la última cubeta se acumulan en ella.
+ */
+static void registrar_profundidad(EstadisticasArbol& estadisticas, uint64_t profundidad) {
+    const uint64_t ultima = EstadisticasArbol::CUBETAS_PROFUNDIDAD - 1;
+    ++estadisticas.histograma_profundidad[static_cast<size_t>(std::min(profundidad, ultima))];
+}
+#endif
+
 // ---------- Nodo ----------
 
 /**
- * @brief Constructor del nodo interno del rbol.
- * @param estudiante Estudiante a almacenar en el nodo.
+ * @brief Constructor del nodo interno del árbol.
+ * @param estudiante Estudiante a mover dentro del nodo.
  * @details
- * Calcula y asigna la clave de promedio en centsimas a partir del
- * promedio del estudiante, toma el ID como clave secundaria y
- * establece los punteros izquierdo y derecho en nullptr.
+ * Calcula y asigna la clave de promedio en centésimas a partir del
+ * promedio del estudiante, toma el ID como clave secundaria,
+ * establece los punteros izquierdo y derecho en nullptr e inicializa
+ * los agregados como los de un subárbol con un único nodo.
  */
-ArbolBinarioBusqueda::Nodo::Nodo(const Estudiante& estudiante)
+ArbolBinarioBusqueda::Nodo::Nodo(Estudiante&& estudiante)
     : clave_promedio_cent(convertir_promedio_a_clave(estudiante.promedio())),
     clave_id(estudiante.id()),
-    dato(estudiante),
+    dato(std::move(estudiante)),
     izquierdo(nullptr),
-    derecho(nullptr) {
+    derecho(nullptr),
+    cantidad_subarbol(1),
+    en_bloque(false),
+    suma_subarbol(clave_promedio_cent),
+    suma_cuadrados_subarbol(static_cast<long long>(clave_promedio_cent) * clave_promedio_cent) {
+#ifdef ABB_MERKLE
+    hash_dato = hash_estudiante(dato);
+    hash_subarbol = hash_dato;
+#endif
 }
 
 // ---------- Constructor / Destructor ----------
 
 /**
- * @brief Constructor por defecto del rbol binario de bsqueda.
+ * @brief Constructor por defecto del árbol binario de búsqueda.
  * @details
- * Inicializa la raz en nullptr, indicando que el rbol comienza vaco.
+ * Inicializa la raíz en nullptr, indicando que el árbol comienza vacío.
  */
-ArbolBinarioBusqueda::ArbolBinarioBusqueda() : raiz_(nullptr) {}
+ArbolBinarioBusqueda::ArbolBinarioBusqueda() : raiz_(nullptr), modo_splay_(false) {
+    ABB_REGISTRAR(estadisticas_.habilitadas = true);
+}
 
 /**
- * @brief Destructor del rbol binario de bsqueda.
+ * @brief Destructor del árbol binario de búsqueda.
  * @details
- * Libera todos los nodos del rbol utilizando un recorrido postorden,
- * para evitar fugas de memoria, y luego pone la raz en nullptr.
+ * Libera todos los nodos del árbol utilizando un recorrido postorden,
+ * para evitar fugas de memoria, y luego pone la raíz en nullptr.
  */
 ArbolBinarioBusqueda::~ArbolBinarioBusqueda() {
     liberar_postorden(raiz_);
     raiz_ = nullptr;
 }
 
+/**
+ * @brief Constructor de movimiento.
+ * @param otro Árbol de origen; queda vacío y utilizable.
+ */
+ArbolBinarioBusqueda::ArbolBinarioBusqueda(ArbolBinarioBusqueda&& otro) noexcept
+    : raiz_(otro.raiz_),
+    estadisticas_(otro.estadisticas_),
+    modo_splay_(otro.modo_splay_),
+    espina_splay_(std::move(otro.espina_splay_)),
+    bloques_(std::move(otro.bloques_)),
+    indice_aprendido_(std::move(otro.indice_aprendido_)),
+    indice_nombres_(std::move(otro.indice_nombres_)),
+    indice_carreras_(std::move(otro.indice_carreras_)),
+    filtro_ids_(std::move(otro.filtro_ids_)),
+    filtro_cantidad_esperada_(otro.filtro_cantidad_esperada_),
+    filtro_tasa_falsos_positivos_(otro.filtro_tasa_falsos_positivos_) {
+    otro.raiz_ = nullptr;
+    otro.bloques_.clear();
+    otro.invalidar_indices();
+    observador_cambios_.swap(otro.observador_cambios_);
+    error_observador_.swap(otro.error_observador_);
+}
+
+/**
+ * @brief Asignación por movimiento.
+ * @param otro Árbol de origen; queda vacío y utilizable.
+ * @return Referencia a este árbol.
+ * @details
+ * Los nodos propios se liberan antes de soltar los bloques propios, porque
+ * algunos de ellos pueden vivir en esos bloques.
+ */
+ArbolBinarioBusqueda& ArbolBinarioBusqueda::operator=(ArbolBinarioBusqueda&& otro) noexcept {
+    if (&otro == this) return *this;
+    liberar_postorden(raiz_);
+    raiz_ = otro.raiz_;
+    otro.raiz_ = nullptr;
+    estadisticas_ = otro.estadisticas_;
+    modo_splay_ = otro.modo_splay_;
+    espina_splay_ = std::move(otro.espina_splay_);
+    bloques_ = std::move(otro.bloques_);
+    otro.bloques_.clear();
+    indice_aprendido_ = std::move(otro.indice_aprendido_);
+    indice_nombres_ = std::move(otro.indice_nombres_);
+    indice_carreras_ = std::move(otro.indice_carreras_);
+    filtro_ids_ = std::move(otro.filtro_ids_);
+    filtro_cantidad_esperada_ = otro.filtro_cantidad_esperada_;
+    filtro_tasa_falsos_positivos_ = otro.filtro_tasa_falsos_positivos_;
+    otro.invalidar_indices();
+    observador_cambios_ = nullptr;
+    observador_cambios_.swap(otro.observador_cambios_);
+    error_observador_ = nullptr;
+    error_observador_.swap(otro.error_observador_);
+    return *this;
+}
+
+/**
+ * @brief Tamaño mínimo de un subárbol para copiarlo en un hilo aparte.
+ * @details
+ * Por debajo de este tamaño crear el hilo cuesta más que la copia.
+ */
+static const int UMBRAL_CLONADO_PARALELO = 16384;
+
+/**
+ * @brief Copia recursiva en preorden hacia el bloque.
+ * @param origen Nodo a copiar.
+ * @param bloque Bloque destino.
+ * @param posicion Posición de la copia.
+ * @param hilos Hilos disponibles para este subárbol.
+ * @return Nodo copiado.
+ * @details
+ * Los hilos se reparten a la mitad entre los dos subárboles. Una excepción
+ * del hilo secundario (por ejemplo std::bad_alloc al copiar un nombre) se
+ * captura y se vuelve a lanzar en el hilo que lo creó después de esperarlo.
+ * Si el hilo no se puede crear, ese subárbol se copia en el hilo actual.
+ *
+ * Si algo falla, la llamada destruye lo que construyó antes de propagar:
+ * cada subárbol que sí terminó y el propio nodo. Una llamada que lanza ya
+ * dejó limpio su subárbol, así que al llegar al bloque no queda ningún
+ * Estudiante vivo y liberarlo no pierde cadenas.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::clonar_recursivo(const Nodo* origen, Nodo* bloque, size_t posicion, unsigned hilos) {
+    Nodo* copia = ::new (static_cast<void*>(bloque + posicion)) Nodo(Estudiante(origen->dato));
+    copia->en_bloque = true;
+    copiar_agregados(copia, origen);
+
+    const size_t posicion_izquierda = posicion + 1;
+    const size_t posicion_derecha = posicion_izquierda + (origen->izquierdo ? origen->izquierdo->cantidad_subarbol : 0);
+    auto deshacer = [copia]() {
+        liberar_postorden(copia->izquierdo);
+        liberar_postorden(copia->derecho);
+        copia->~Nodo();
+    };
+
+    if (hilos > 1 && origen->izquierdo && origen->derecho && origen->izquierdo->cantidad_subarbol >= UMBRAL_CLONADO_PARALELO) {
+        const unsigned hilos_izquierda = hilos / 2;
+        exception_ptr error;
+        optional<thread> hilo_izquierdo;
+        try {
+            hilo_izquierdo.emplace([&]() {
+                try { copia->izquierdo = clonar_recursivo(origen->izquierdo, bloque, posicion_izquierda, hilos_izquierda); }
+                catch (...) { error = current_exception(); }
+                });
+        }
+        catch (const system_error&) {}
+
+        exception_ptr error_derecho;
+        try { copia->derecho = clonar_recursivo(origen->derecho, bloque, posicion_derecha, hilos - hilos_izquierda); }
+        catch (...) { error_derecho = current_exception(); }
+        if (hilo_izquierdo) {
+            hilo_izquierdo->join();
+        }
+        else if (!error_derecho) {
+            try { copia->izquierdo = clonar_recursivo(origen->izquierdo, bloque, posicion_izquierda, 1); }
+            catch (...) { error = current_exception(); }
+        }
+        if (error_derecho) error = error_derecho;
+        if (error) {
+            deshacer();
+            rethrow_exception(error);
+        }
+        return copia;
+    }
+
+    try {
+        if (origen->izquierdo) copia->izquierdo = clonar_recursivo(origen->izquierdo, bloque, posicion_izquierda, hilos);
+        if (origen->derecho) copia->derecho = clonar_recursivo(origen->derecho, bloque, posicion_derecha, hilos);
+    }
+    catch (...) {
+        deshacer();
+        throw;
+    }
+    return copia;
+}
+
+/**
+ * @brief Copia profunda en un bloque contiguo.
+ * @return Árbol independiente con el mismo contenido y forma.
+ * @details
+ * El bloque se registra en la copia antes de llenarlo. Si una copia falla,
+ * clonar_recursivo ya destruyó los nodos construidos, la excepción se
+ * propaga y el bloque se libera con la copia sin perder memoria.
+ */
+ArbolBinarioBusqueda ArbolBinarioBusqueda::clonar() const {
+    ArbolBinarioBusqueda copia;
+    copia.modo_splay_ = modo_splay_;
+    if (filtro_ids_) copia.filtro_ids_ = make_unique<FiltroBloom>(*filtro_ids_);
+    copia.filtro_cantidad_esperada_ = filtro_cantidad_esperada_;
+    copia.filtro_tasa_falsos_positivos_ = filtro_tasa_falsos_positivos_;
+    if (raiz_ == nullptr) return copia;
+
+    const size_t cantidad = static_cast<size_t>(raiz_->cantidad_subarbol);
+    copia.bloques_.push_back(shared_ptr<void>(::operator new(cantidad * sizeof(Nodo)), [](void* memoria) { ::operator delete(memoria); }));
+    const unsigned hilos = std::max(1u, thread::hardware_concurrency());
+    copia.raiz_ = clonar_recursivo(raiz_, static_cast<Nodo*>(copia.bloques_.back().get()), 0, hilos);
+    return copia;
+}
+
 // ---------- Utilidades privadas ----------
 
 /**
- * @brief Compara dos claves (promedio en centsimas, id).
- * @param g1 Promedio (en centsimas) del primer elemento.
+ * @brief Compara dos claves (promedio en centésimas, id).
+ * @param g1 Promedio (en centésimas) del primer elemento.
  * @param id1 ID del primer elemento.
- * @param g2 Promedio (en centsimas) del segundo elemento.
+ * @param g2 Promedio (en centésimas) del segundo elemento.
  * @param id2 ID del segundo elemento.
  * @return
  * - -1 si (g1, id1) es menor que (g2, id2)
  * -  1 si (g1, id1) es mayor que (g2, id2)
  * -  0 si ambas claves son equivalentes.
  * @details
- * La comparacin se realiza primero por promedio; si los promedios
+ * La comparación se realiza primero por promedio; si los promedios
  * son iguales, se desempata usando el ID.
  */
 int ArbolBinarioBusqueda::comparar_claves(int g1, int id1, int g2, int id2) {
@@ -68,99 +277,683 @@ int ArbolBinarioBusqueda::comparar_claves(int g1, int id1, int g2, int id2) {
 }
 
 /**
- * @brief Libera recursivamente todos los nodos de un subrbol en postorden.
- * @param nodo Nodo raz del subrbol a liberar.
+ * @brief Libera recursivamente todos los nodos de un subárbol en postorden.
+ * @param nodo Nodo raíz del subárbol a liberar.
  * @details
- * Primero se libera el subrbol izquierdo, luego el derecho y por ltimo
- * el nodo actual. Esta funcin se utiliza en el destructor del rbol.
+ * Primero se libera el subárbol izquierdo, luego el derecho y por último
+ * el nodo actual. Esta función se utiliza en el destructor del árbol.
  */
 void ArbolBinarioBusqueda::liberar_postorden(Nodo* nodo) {
     if (nodo == nullptr) return;
     liberar_postorden(nodo->izquierdo);
     liberar_postorden(nodo->derecho);
-    delete nodo;
+    liberar_nodo(nodo);
 }
 
-// ---------- Insercin / Bsqueda ----------
+/**
+ * @brief Libera un nodo con delete o, si está en un bloque, solo lo destruye.
+ * @param nodo Nodo a liberar.
+ */
+void ArbolBinarioBusqueda::liberar_nodo(Nodo* nodo) {
+    if (nodo->en_bloque) nodo->~Nodo();
+    else delete nodo;
+}
 
 /**
- * @brief Inserta un estudiante de forma recursiva en el subrbol dado.
- * @param nodo Raz actual del subrbol donde se desea insertar.
- * @param estudiante Estudiante a insertar o actualizar.
- * @return Nueva raz del subrbol tras la operacin de insercin.
+ * @brief Recalcula los agregados de un nodo con base en sus hijos.
+ * @param nodo Nodo a actualizar.
  * @details
- * Si la posicin adecuada est vaca (nodo == nullptr), se crea un nuevo
+ * cantidad = 1 + cantidad(izq) + cantidad(der), y lo mismo para la suma de
+ * claves y la suma de sus cuadrados. Un hijo nullptr aporta cero.
+ */
+void ArbolBinarioBusqueda::recalcular_agregados(Nodo* nodo) {
+    const long long clave = nodo->clave_promedio_cent;
+    nodo->cantidad_subarbol = 1;
+    nodo->suma_subarbol = clave;
+    nodo->suma_cuadrados_subarbol = clave * clave;
+    for (Nodo* hijo : { nodo->izquierdo, nodo->derecho }) {
+        if (hijo == nullptr) continue;
+        nodo->cantidad_subarbol += hijo->cantidad_subarbol;
+        nodo->suma_subarbol += hijo->suma_subarbol;
+        nodo->suma_cuadrados_subarbol += hijo->suma_cuadrados_subarbol;
+    }
+#ifdef ABB_MERKLE
+    nodo->hash_subarbol = nodo->hash_dato;
+    if (nodo->izquierdo) nodo->hash_subarbol += nodo->izquierdo->hash_subarbol;
+    if (nodo->derecho) nodo->hash_subarbol += nodo->derecho->hash_subarbol;
+#endif
+}
+
+/**
+ * @brief Copia cantidad, suma, suma de cuadrados y, con ABB_MERKLE, el hash del subárbol.
+ * @param destino Nodo destino.
+ * @param origen Nodo origen.
+ */
+void ArbolBinarioBusqueda::copiar_agregados(Nodo* destino, const Nodo* origen) {
+    destino->cantidad_subarbol = origen->cantidad_subarbol;
+    destino->suma_subarbol = origen->suma_subarbol;
+    destino->suma_cuadrados_subarbol = origen->suma_cuadrados_subarbol;
+#ifdef ABB_MERKLE
+    destino->hash_subarbol = origen->hash_subarbol;
+#endif
+}
+
+// ---------- Rotaciones / splay ----------
+
+/**
+ * @brief Rotación simple a la derecha.
+ * @param nodo Raíz del subárbol (con hijo izquierdo).
+ * @return El antiguo hijo izquierdo, ahora raíz.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::rotar_derecha(Nodo* nodo) {
+    Nodo* hijo = nodo->izquierdo;
+    nodo->izquierdo = hijo->derecho;
+    hijo->derecho = nodo;
+    recalcular_agregados(nodo);
+    recalcular_agregados(hijo);
+    return hijo;
+}
+
+/**
+ * @brief Rotación simple a la izquierda.
+ * @param nodo Raíz del subárbol (con hijo derecho).
+ * @return El antiguo hijo derecho, ahora raíz.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::rotar_izquierda(Nodo* nodo) {
+    Nodo* hijo = nodo->derecho;
+    nodo->derecho = hijo->izquierdo;
+    hijo->izquierdo = nodo;
+    recalcular_agregados(nodo);
+    recalcular_agregados(hijo);
+    return hijo;
+}
+
+/**
+ * @brief Splay descendente hacia una clave.
+ * @param raiz Raíz actual.
+ * @param clave_promedio_cent Promedio buscado.
+ * @param clave_id ID buscado.
+ * @param solo_promedio true para comparar solo por promedio.
+ * @param contadores Contadores donde se registran las visitas.
+ * @return Nueva raíz.
+ * @details
+ * Los nodos mayores que la clave se cuelgan, en orden, como hijos izquierdos
+ * del árbol "mayores" y los menores como hijos derechos del árbol "menores".
+ * Al terminar, los subárboles del nodo final completan ambos árboles y se
+ * recalculan los agregados de los nodos colgados de abajo hacia arriba.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::splay(Nodo* raiz, int clave_promedio_cent, int clave_id, bool solo_promedio,
+    [[maybe_unused]] ContadoresOperacion& contadores) {
+    if (raiz == nullptr) return nullptr;
+    auto comparar = [&](const Nodo* nodo) {
+        if (solo_promedio) return (clave_promedio_cent > nodo->clave_promedio_cent) - (clave_promedio_cent < nodo->clave_promedio_cent);
+        return comparar_claves(clave_promedio_cent, clave_id, nodo->clave_promedio_cent, nodo->clave_id);
+    };
+
+    Nodo* menores = nullptr;
+    Nodo* mayores = nullptr;
+    Nodo** enganche_menores = &menores;
+    Nodo** enganche_mayores = &mayores;
+    espina_splay_.clear();
+
+    Nodo* nodo_actual = raiz;
+    while (true) {
+        ABB_REGISTRAR(++contadores.visitas);
+        ABB_REGISTRAR(++contadores.comparaciones);
+        const int comparacion = comparar(nodo_actual);
+        if (comparacion < 0) {
+            if (nodo_actual->izquierdo == nullptr) break;
+            if (comparar(nodo_actual->izquierdo) < 0) { // zig-zig
+                nodo_actual = rotar_derecha(nodo_actual);
+                if (nodo_actual->izquierdo == nullptr) break;
+            }
+            *enganche_mayores = nodo_actual;
+            espina_splay_.push_back(nodo_actual);
+            enganche_mayores = &nodo_actual->izquierdo;
+            nodo_actual = nodo_actual->izquierdo;
+        }
+        else if (comparacion > 0) {
+            if (nodo_actual->derecho == nullptr) break;
+            if (comparar(nodo_actual->derecho) > 0) { // zag-zag
+                nodo_actual = rotar_izquierda(nodo_actual);
+                if (nodo_actual->derecho == nullptr) break;
+            }
+            *enganche_menores = nodo_actual;
+            espina_splay_.push_back(nodo_actual);
+            enganche_menores = &nodo_actual->derecho;
+            nodo_actual = nodo_actual->derecho;
+        }
+        else {
+            break;
+        }
+    }
+
+    *enganche_menores = nodo_actual->izquierdo;
+    *enganche_mayores = nodo_actual->derecho;
+    for (auto nodo = espina_splay_.rbegin(); nodo != espina_splay_.rend(); ++nodo) recalcular_agregados(*nodo);
+    nodo_actual->izquierdo = menores;
+    nodo_actual->derecho = mayores;
+    recalcular_agregados(nodo_actual);
+    return nodo_actual;
+}
+
+// ---------- Balanceo (Day-Stout-Warren) ----------
+
+/**
+ * @brief Compresión de la espina derecha.
+ * @param raiz Raíz de la espina.
+ * @param cantidad Cantidad de rotaciones a aplicar.
+ */
+void ArbolBinarioBusqueda::comprimir_espina(Nodo*& raiz, int cantidad) {
+    Nodo** enlace = &raiz;
+    for (int rotacion = 0; rotacion < cantidad; ++rotacion) {
+        *enlace = rotar_izquierda(*enlace);
+        enlace = &(*enlace)->derecho;
+    }
+}
+
+/**
+ * @brief Rebalancea el árbol completo en O(n).
+ * @details
+ * Fase 1 (espina): mientras el nodo apuntado por el enlace tenga hijo
+ * izquierdo, se rota a la derecha; si no, se avanza por la derecha.
+ * Fase 2: con m = 2^floor(log2(n + 1)) - 1, se comprimen primero los n - m
+ * nodos sobrantes (que forman el último nivel) y después se comprime con
+ * m/2, m/4, ... hasta 1. Las rotaciones recalculan los agregados de los dos
+ * nodos que tocan; el resto de los subárboles conserva sus mismos nodos.
+ */
+void ArbolBinarioBusqueda::rebalancear() {
+    descongelar();
+    int cantidad = 0;
+    Nodo** enlace = &raiz_;
+    while (*enlace != nullptr) {
+        if ((*enlace)->izquierdo != nullptr) {
+            *enlace = rotar_derecha(*enlace);
+        }
+        else {
+            ++cantidad;
+            enlace = &(*enlace)->derecho;
+        }
+    }
+
+    int completos = 1;
+    while (completos <= (cantidad + 1) / 2) completos *= 2;
+    completos -= 1; // 2^floor(log2(n + 1)) - 1
+    comprimir_espina(raiz_, cantidad - completos);
+    while (completos > 1) {
+        completos /= 2;
+        comprimir_espina(raiz_, completos);
+    }
+}
+
+// ---------- Localidad de memoria ----------
+
+/**
+ * @brief Orden van Emde Boas de los primeros niveles de un subárbol.
+ * @param nodo Raíz del subárbol.
+ * @param niveles Niveles a colocar.
+ * @param orden Vector de salida.
+ * @details
+ * Las raíces de los árboles inferiores se buscan con una pila explícita
+ * (preorden con profundidad, apilando primero el hijo derecho), así que
+ * quedan de izquierda a derecha y la búsqueda no depende de la recursión.
+ */
+void ArbolBinarioBusqueda::colocar_van_emde_boas(Nodo* nodo, int niveles, vector<Nodo*>& orden) {
+    if (nodo == nullptr || niveles <= 0) return;
+    if (niveles == 1) { orden.push_back(nodo); return; }
+
+    const int niveles_superiores = niveles / 2;
+    colocar_van_emde_boas(nodo, niveles_superiores, orden);
+
+    stack<pair<Nodo*, int>> pendientes;
+    pendientes.push({ nodo, 0 });
+    while (!pendientes.empty()) {
+        auto [actual, profundidad] = pendientes.top();
+        pendientes.pop();
+        if (profundidad == niveles_superiores) {
+            colocar_van_emde_boas(actual, niveles - niveles_superiores, orden);
+            continue;
+        }
+        if (actual->derecho) pendientes.push({ actual->derecho, profundidad + 1 });
+        if (actual->izquierdo) pendientes.push({ actual->izquierdo, profundidad + 1 });
+    }
+}
+
+/**
+ * @brief Mueve todos los nodos a un bloque contiguo en orden van Emde Boas.
+ * @details
+ * Reserva el bloque y calcula el orden antes de tocar el árbol, así que si
+ * una reserva falla el árbol queda intacto. Luego, en tres pasadas:
+ * 1. Construye cada nodo nuevo en su posición moviendo el Estudiante, copia
+ *    hijos (aún los viejos) y agregados, y deja en el derecho del nodo viejo
+ *    la dirección de su reemplazo.
+ * 2. Traduce los hijos de cada nodo nuevo a través de esas direcciones.
+ * 3. Libera los nodos viejos.
+ * Al terminar, los bloques anteriores ya no tienen nodos de este árbol y se sueltan.
+ */
+void ArbolBinarioBusqueda::compactar() {
+    if (raiz_ == nullptr) return;
+    invalidar_indices();
+    const size_t cantidad = static_cast<size_t>(raiz_->cantidad_subarbol);
+    shared_ptr<void> bloque(::operator new(cantidad * sizeof(Nodo)), [](void* memoria) { ::operator delete(memoria); });
+    vector<Nodo*> orden;
+    orden.reserve(cantidad);
+    colocar_van_emde_boas(raiz_, altura() + 1, orden);
+
+    Nodo* destino = static_cast<Nodo*>(bloque.get());
+    for (size_t posicion = 0; posicion < cantidad; ++posicion) {
+        Nodo* viejo = orden[posicion];
+        Nodo* nuevo = ::new (static_cast<void*>(destino + posicion)) Nodo(std::move(viejo->dato));
+        nuevo->en_bloque = true;
+        nuevo->izquierdo = viejo->izquierdo;
+        nuevo->derecho = viejo->derecho;
+        copiar_agregados(nuevo, viejo);
+        viejo->derecho = nuevo; // dirección de reenvío
+    }
+    for (size_t posicion = 0; posicion < cantidad; ++posicion) {
+        Nodo* nuevo = destino + posicion;
+        if (nuevo->izquierdo) nuevo->izquierdo = nuevo->izquierdo->derecho;
+        if (nuevo->derecho) nuevo->derecho = nuevo->derecho->derecho;
+    }
+    raiz_ = raiz_->derecho;
+    for (Nodo* viejo : orden) liberar_nodo(viejo);
+
+    bloques_.clear();
+    bloques_.push_back(std::move(bloque));
+}
+
+/**
+ * @brief Activa o desactiva el modo splay.
+ * @param activo Nuevo estado.
+ */
+void ArbolBinarioBusqueda::set_modo_splay(bool activo) { modo_splay_ = activo; }
+
+/**
+ * @brief Indica si el modo splay está activo.
+ * @return true si está activo.
+ */
+bool ArbolBinarioBusqueda::modo_splay() const { return modo_splay_; }
+
+// ---------- Filtro de IDs ----------
+
+/**
+ * @brief Crea el filtro con los parámetros dados y lo llena con los IDs actuales.
+ * @param cantidad_esperada IDs esperados.
+ * @param tasa_falsos_positivos Tasa de falsos positivos.
+ */
+void ArbolBinarioBusqueda::activar_filtro_ids(size_t cantidad_esperada, double tasa_falsos_positivos) {
+    filtro_ids_ = make_unique<FiltroBloom>(cantidad_esperada, tasa_falsos_positivos);
+    filtro_cantidad_esperada_ = cantidad_esperada;
+    filtro_tasa_falsos_positivos_ = tasa_falsos_positivos;
+    reconstruir_filtro_ids();
+}
+
+/**
+ * @brief Libera el filtro de IDs.
+ */
+void ArbolBinarioBusqueda::desactivar_filtro_ids() { filtro_ids_.reset(); }
+
+/**
+ * @brief Indica si el filtro de IDs está activo.
+ * @return true si buscar_por_id consulta el filtro.
+ */
+bool ArbolBinarioBusqueda::filtro_ids_activo() const { return filtro_ids_ != nullptr; }
+
+/**
+ * @brief Reemplaza el filtro por uno nuevo con los IDs actuales.
+ */
+void ArbolBinarioBusqueda::reconstruir_filtro_ids() {
+    if (!filtro_ids_) return;
+    const size_t cantidad = raiz_ ? static_cast<size_t>(raiz_->cantidad_subarbol) : 0;
+    filtro_ids_ = make_unique<FiltroBloom>(std::max(filtro_cantidad_esperada_, cantidad), filtro_tasa_falsos_positivos_);
+    agregar_ids_al_filtro(raiz_);
+}
+
+/**
+ * @brief Recorre el subárbol con una pila explícita y agrega cada ID al filtro.
+ * @param nodo Raíz del subárbol.
+ */
+void ArbolBinarioBusqueda::agregar_ids_al_filtro(const Nodo* nodo) {
+    if (!filtro_ids_ || nodo == nullptr) return;
+    vector<const Nodo*> pendientes;
+    pendientes.push_back(nodo);
+    while (!pendientes.empty()) {
+        const Nodo* actual = pendientes.back();
+        pendientes.pop_back();
+        filtro_ids_->agregar(static_cast<uint32_t>(actual->clave_id));
+        if (actual->izquierdo) pendientes.push_back(actual->izquierdo);
+        if (actual->derecho) pendientes.push_back(actual->derecho);
+    }
+}
+
+// ---------- Índice aprendido ----------
+
+/**
+ * @brief Descarta el índice aprendido y los índices de nombres y carreras.
+ */
+void ArbolBinarioBusqueda::invalidar_indices() {
+    descongelar();
+    indice_nombres_.reset();
+    indice_carreras_.reset();
+}
+
+/**
+ * @brief Descarta el índice aprendido y libera sus arreglos.
+ */
+void ArbolBinarioBusqueda::descongelar() {
+    if (indice_aprendido_.valido || !indice_aprendido_.entradas.empty()) indice_aprendido_ = IndiceAprendido();
+}
+
+/**
+ * @brief Construye los arreglos ordenados y el modelo lineal por tramos.
+ * @details
+ * Los puntos del modelo son (clave, primera posición de la clave), uno por
+ * promedio distinto. Cada tramo empieza en un punto y mantiene el intervalo
+ * de pendientes que deja a todos sus puntos a lo sumo a
+ * ERROR_INDICE_APRENDIDO posiciones de la recta; cuando el intervalo queda
+ * vacío, el punto actual abre el tramo siguiente. La pendiente elegida es
+ * el centro del intervalo final.
+ */
+void ArbolBinarioBusqueda::congelar() {
+    descongelar();
+    vector<const Nodo*> nodos;
+    nodos.reserve(raiz_ ? static_cast<size_t>(raiz_->cantidad_subarbol) : 0);
+    recolectar_inorden(raiz_, nodos);
+
+    IndiceAprendido& indice = indice_aprendido_;
+    indice.entradas.reserve(nodos.size());
+    for (const Nodo* nodo : nodos) indice.entradas.push_back({ nodo->clave_promedio_cent, nodo->clave_id, &nodo->dato });
+
+    const size_t total = indice.entradas.size();
+    const double error = ERROR_INDICE_APRENDIDO;
+    size_t inicio = 0;
+    while (inicio < total) {
+        const int clave_inicio = indice.entradas[inicio].clave_promedio_cent;
+        double pendiente_minima = 0.0, pendiente_maxima = numeric_limits<double>::infinity();
+        size_t punto = inicio;
+        while (punto < total && indice.entradas[punto].clave_promedio_cent == clave_inicio) ++punto;
+        while (punto < total) {
+            const double distancia = static_cast<double>(indice.entradas[punto].clave_promedio_cent) - clave_inicio;
+            const double desplazamiento = static_cast<double>(punto - inicio);
+            const double nueva_minima = std::max(pendiente_minima, (desplazamiento - error) / distancia);
+            const double nueva_maxima = std::min(pendiente_maxima, (desplazamiento + error) / distancia);
+            if (nueva_minima > nueva_maxima) break;
+            pendiente_minima = nueva_minima;
+            pendiente_maxima = nueva_maxima;
+            const int clave_punto = indice.entradas[punto].clave_promedio_cent;
+            while (punto < total && indice.entradas[punto].clave_promedio_cent == clave_punto) ++punto;
+        }
+        const double pendiente = pendiente_maxima == numeric_limits<double>::infinity() ? 0.0 : (pendiente_minima + pendiente_maxima) / 2.0;
+        indice.segmentos.push_back({ clave_inicio, static_cast<int>(inicio), pendiente });
+        inicio = punto;
+    }
+    indice.valido = true;
+}
+
+/**
+ * @brief Indica si el índice aprendido está vigente.
+ * @return true si el árbol está congelado.
+ */
+bool ArbolBinarioBusqueda::congelado() const { return indice_aprendido_.valido; }
+
+/**
+ * @brief Predice la posición y la corrige con una búsqueda local.
+ * @param clave_promedio_cent Clave de promedio.
+ * @param clave_id ID de desempate.
+ * @param estricta true para la primera clave estrictamente mayor.
+ * @return Posición resultante.
+ * @details
+ * La ventana [inferior, superior) es válida cuando la posición anterior a
+ * inferior está antes de la respuesta y la última de la ventana no; si no,
+ * se amplía hacia el lado que falla. Luego basta una búsqueda binaria
+ * dentro de la ventana.
+ */
+size_t ArbolBinarioBusqueda::posicion_aprendida(int clave_promedio_cent, int clave_id, bool estricta, ContadoresOperacion* contadores) const {
+    (void)contadores; // solo se usa con ABB_ESTADISTICAS
+    const IndiceAprendido& indice = indice_aprendido_;
+    const size_t total = indice.entradas.size();
+    if (total == 0) return 0;
+    // El arreglo de IDs solo se lee ante un empate de promedio que el ID pueda desempatar.
+    const bool sin_desempate = clave_id == INT_MIN && !estricta;
+    auto antes = [&](size_t posicion) {
+        ABB_REGISTRAR(if (contadores) { ++contadores->visitas; ++contadores->comparaciones; });
+        const IndiceAprendido::Entrada& entrada = indice.entradas[posicion];
+        if (entrada.clave_promedio_cent != clave_promedio_cent) return entrada.clave_promedio_cent < clave_promedio_cent;
+        if (sin_desempate) return false;
+        return entrada.id < clave_id || (estricta && entrada.id == clave_id);
+        };
+
+    auto segmento = upper_bound(indice.segmentos.begin(), indice.segmentos.end(), clave_promedio_cent,
+        [](int clave, const IndiceAprendido::Segmento& tramo) { return clave < tramo.clave_inicio; });
+    double prediccion = 0.0;
+    if (segmento != indice.segmentos.begin()) {
+        --segmento;
+        prediccion = segmento->posicion_inicio + segmento->pendiente * (clave_promedio_cent - segmento->clave_inicio);
+    }
+    const size_t estimada = static_cast<size_t>(std::clamp(prediccion, 0.0, static_cast<double>(total - 1)));
+
+    const size_t error = ERROR_INDICE_APRENDIDO;
+    size_t inferior = estimada > error ? estimada - error : 0;
+    size_t superior = std::min(total, estimada + error + 1);
+    for (size_t paso = error + 1; inferior > 0 && !antes(inferior - 1); paso *= 2) inferior = inferior > paso ? inferior - paso : 0;
+    for (size_t paso = error + 1; superior < total && antes(superior - 1); paso *= 2) superior = std::min(total, superior + paso);
+
+    while (inferior < superior) {
+        const size_t medio = inferior + (superior - inferior) / 2;
+        if (antes(medio)) inferior = medio + 1;
+        else superior = medio;
+    }
+    return inferior;
+}
+
+// ---------- Inserción / Búsqueda ----------
+
+/**
+ * @brief Inserta un estudiante de forma recursiva en el subárbol dado.
+ * @param nodo Raíz actual del subárbol donde se desea insertar.
+ * @param estudiante Estudiante a insertar o actualizar; se mueve a su destino.
+ * @param clave_promedio_cent Promedio del estudiante en centésimas.
+ * @return Nueva raíz del subárbol tras la operación de inserción.
+ * @details
+ * Si la posición adecuada está vacía (nodo == nullptr), se crea un nuevo
  * nodo. Si la clave ya existe, se actualiza el dato del nodo con el nuevo
- * estudiante.
+ * estudiante. En ambos casos el estudiante se mueve, sin copiar sus cadenas.
  */
-ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::insertar_recursivo(Nodo* nodo, const Estudiante& estudiante) {
-    if (nodo == nullptr) return new Nodo(estudiante);
-    const int clave_promedio_nuevo = convertir_promedio_a_clave(estudiante.promedio());
-    const int comparacion = comparar_claves(clave_promedio_nuevo, estudiante.id(), nodo->clave_promedio_cent, nodo->clave_id);
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::insertar_recursivo(Nodo* nodo, Estudiante&& estudiante, int clave_promedio_cent) {
+    if (nodo == nullptr) {
+        ABB_REGISTRAR(++estadisticas_.insercion.asignaciones);
+        Nodo* nuevo = new Nodo(std::move(estudiante));
+        if (indice_nombres_) indice_nombres_->insertar(&nuevo->dato);
+        if (indice_carreras_) indice_carreras_->emplace(ClaveCarrera{ nuevo->dato.codigo_carrera(), nuevo->clave_promedio_cent, nuevo->clave_id }, &nuevo->dato);
+        if (filtro_ids_) filtro_ids_->agregar(static_cast<uint32_t>(nuevo->clave_id));
+        return nuevo;
+    }
+    ABB_REGISTRAR(++estadisticas_.insercion.visitas);
+    ABB_REGISTRAR(++estadisticas_.insercion.comparaciones);
+    const int comparacion = comparar_claves(clave_promedio_cent, estudiante.id(), nodo->clave_promedio_cent, nodo->clave_id);
 
     if (comparacion < 0) {
-        nodo->izquierdo = insertar_recursivo(nodo->izquierdo, estudiante);
+        nodo->izquierdo = insertar_recursivo(nodo->izquierdo, std::move(estudiante), clave_promedio_cent);
     }
     else if (comparacion > 0) {
-        nodo->derecho = insertar_recursivo(nodo->derecho, estudiante);
+        nodo->derecho = insertar_recursivo(nodo->derecho, std::move(estudiante), clave_promedio_cent);
     }
     else {
-        nodo->dato = estudiante; // misma clave: actualiza
+        const bool reindexar = indice_nombres_ && nodo->dato.nombre() != estudiante.nombre();
+        if (reindexar) indice_nombres_->quitar(nodo->dato.nombre(), &nodo->dato);
+        if (indice_carreras_ && nodo->dato.codigo_carrera() != estudiante.codigo_carrera()) {
+            indice_carreras_->erase(ClaveCarrera{ nodo->dato.codigo_carrera(), nodo->clave_promedio_cent, nodo->clave_id });
+            indice_carreras_->emplace(ClaveCarrera{ estudiante.codigo_carrera(), nodo->clave_promedio_cent, nodo->clave_id }, &nodo->dato);
+        }
+        nodo->dato = std::move(estudiante); // misma clave: actualiza
+        if (reindexar) indice_nombres_->insertar(&nodo->dato);
+#ifdef ABB_MERKLE
+        nodo->hash_dato = hash_estudiante(nodo->dato);
+#endif
     }
+    recalcular_agregados(nodo);
     return nodo;
 }
 
 /**
- * @brief Inserta un estudiante en el rbol.
+ * @brief Inserta un estudiante en el árbol.
  * @param estudiante Estudiante a insertar.
  * @details
- * Llama internamente a la versin recursiva de insercin partiendo desde
- * la raz y actualiza la raz en caso de que el rbol estuviera vaco.
+ * Hace una única copia del estudiante y delega en la versión por movimiento.
  */
 void ArbolBinarioBusqueda::insertar(const Estudiante& estudiante) {
-    raiz_ = insertar_recursivo(raiz_, estudiante);
+    insertar(Estudiante(estudiante));
 }
 
 /**
- * @brief Busca un nodo por promedio (en centsimas) de forma recursiva.
- * @param nodo Raz del subrbol donde se realiza la bsqueda.
- * @param clave_promedio_cent Promedio en centsimas a buscar.
- * @return Puntero al nodo encontrado o nullptr si no se encuentra.
+ * @brief Inserta un estudiante moviéndolo al árbol.
+ * @param estudiante Estudiante a mover.
  * @details
- * Aprovecha la propiedad de orden del rbol, y se mueve a izquierda o derecha
- * dependiendo de si la clave buscada es menor o mayor que la del nodo actual.
+ * Calcula la clave de promedio una sola vez, llama a la versión recursiva
+ * partiendo desde la raíz y actualiza la raíz en caso de que el árbol
+ * estuviera vacío. Si hay un observador de cambios, vuelve a descender por
+ * la clave completa (el camino ya está en caché) y le entrega el estudiante
+ * guardado; una excepción del observador queda en error_observador_.
  */
-ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::buscar_por_promedio_recursivo(Nodo* nodo, int clave_promedio_cent) {
-    if (nodo == nullptr) return nullptr;
-    if (clave_promedio_cent < nodo->clave_promedio_cent) return buscar_por_promedio_recursivo(nodo->izquierdo, clave_promedio_cent);
-    if (clave_promedio_cent > nodo->clave_promedio_cent) return buscar_por_promedio_recursivo(nodo->derecho, clave_promedio_cent);
-    return nodo; // primer match del promedio
+void ArbolBinarioBusqueda::insertar(Estudiante&& estudiante) {
+    ABB_REGISTRAR(++estadisticas_.insercion.llamadas);
+    descongelar();
+    const int clave_promedio_cent = convertir_promedio_a_clave(estudiante.promedio());
+    const int clave_id = estudiante.id();
+    raiz_ = insertar_recursivo(raiz_, std::move(estudiante), clave_promedio_cent);
+    if (modo_splay_) raiz_ = splay(raiz_, clave_promedio_cent, clave_id, false, estadisticas_.insercion);
+
+    if (observador_cambios_) {
+        Nodo* nodo = raiz_;
+        int comparacion;
+        while (nodo != nullptr && (comparacion = comparar_claves(clave_promedio_cent, clave_id, nodo->clave_promedio_cent, nodo->clave_id)) != 0) {
+            nodo = comparacion < 0 ? nodo->izquierdo : nodo->derecho;
+        }
+        if (nodo != nullptr) {
+            try { observador_cambios_(nodo->dato); }
+            catch (...) { if (!error_observador_) error_observador_ = current_exception(); }
+        }
+    }
+}
+
+/**
+ * @brief Registra el observador de cambios y descarta el error anterior.
+ * @param observador Función a notificar (vacía para desactivar).
+ */
+void ArbolBinarioBusqueda::set_observador_cambios(function<void(const Estudiante&)> observador) {
+    observador_cambios_ = std::move(observador);
+    error_observador_ = nullptr;
+}
+
+/**
+ * @brief Devuelve la primera excepción del observador.
+ * @return Excepción guardada o nula.
+ */
+exception_ptr ArbolBinarioBusqueda::error_observador() const {
+    return error_observador_;
+}
+
+/**
+ * @brief Descarta la excepción guardada del observador.
+ */
+void ArbolBinarioBusqueda::limpiar_error_observador() {
+    error_observador_ = nullptr;
+}
+
+/**
+ * @brief Construye e inserta un estudiante sin copias de sus cadenas.
+ * @param id Identificador del estudiante.
+ * @param nombre Nombre, movido hasta el nodo.
+ * @param carrera Carrera, internada en el diccionario compartido.
+ * @param promedio Promedio en escala 0.0 - 100.0.
+ */
+void ArbolBinarioBusqueda::emplazar(int id, string nombre, string_view carrera, double promedio) {
+    insertar(Estudiante(id, std::move(nombre), carrera, promedio));
+}
+
+/**
+ * @brief Busca el primer nodo con un promedio (en centésimas) en orden (promedio, ID).
+ * @param nodo Raíz del subárbol donde se realiza la búsqueda.
+ * @param clave_promedio_cent Promedio en centésimas a buscar.
+ * @return El nodo de menor ID con ese promedio o nullptr si no se encuentra.
+ * @details
+ * Es una cota inferior de (promedio, ID mínimo) en un solo descenso
+ * iterativo: si la clave del nodo es menor sigue por la derecha; si no, lo
+ * anota cuando coincide y sigue por la izquierda, donde estaría un ID menor
+ * con el mismo promedio. La última coincidencia anotada es la respuesta.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::buscar_primero_por_promedio(Nodo* nodo, int clave_promedio_cent) {
+    Nodo* encontrado = nullptr;
+    while (nodo != nullptr) {
+        ABB_REGISTRAR(++estadisticas_.busqueda_promedio.visitas);
+        ABB_REGISTRAR(++estadisticas_.busqueda_promedio.comparaciones);
+        if (clave_promedio_cent > nodo->clave_promedio_cent) {
+            nodo = nodo->derecho;
+            continue;
+        }
+        if (clave_promedio_cent == nodo->clave_promedio_cent) encontrado = nodo;
+        nodo = nodo->izquierdo;
+    }
+    return encontrado;
 }
 
 /**
  * @brief Busca un estudiante por su promedio (coincidencia exacta).
- * @param promedio Promedio acadmico en escala 0.0 - 100.0.
+ * @param promedio Promedio académico en escala 0.0 - 100.0.
  * @return Puntero constante al estudiante si se encuentra, nullptr en caso contrario.
  * @details
- * Convierte el promedio a su clave en centsimas y realiza una bsqueda
- * recursiva en el rbol. Devuelve el primer nodo que coincida con ese promedio.
+ * Convierte el promedio a su clave en centésimas y busca la cota inferior de
+ * (promedio, ID mínimo), así que entre varios estudiantes con ese promedio
+ * devuelve siempre el de menor ID, igual que el índice aprendido. En modo
+ * splay se lleva a la raíz esa misma cota: si el splay termina en el
+ * predecesor, la respuesta es el mínimo de su subárbol derecho y se vuelve a
+ * subir. Las tres rutas registran visitas y profundidad en las estadísticas.
  */
 const Estudiante* ArbolBinarioBusqueda::buscar_por_promedio(double promedio) {
     const int clave_busqueda = convertir_promedio_a_clave(promedio);
-    Nodo* nodo_encontrado = buscar_por_promedio_recursivo(raiz_, clave_busqueda);
+    ABB_REGISTRAR(++estadisticas_.busqueda_promedio.llamadas);
+    ABB_REGISTRAR(const uint64_t visitas_previas = estadisticas_.busqueda_promedio.visitas);
+    Nodo* nodo_encontrado;
+    if (indice_aprendido_.valido) {
+        const size_t posicion = posicion_aprendida(clave_busqueda, INT_MIN, false, &estadisticas_.busqueda_promedio);
+        const bool encontrado = posicion < indice_aprendido_.entradas.size() && indice_aprendido_.entradas[posicion].clave_promedio_cent == clave_busqueda;
+        ABB_REGISTRAR(registrar_profundidad(estadisticas_, estadisticas_.busqueda_promedio.visitas - visitas_previas));
+        return encontrado ? indice_aprendido_.entradas[posicion].estudiante : nullptr;
+    }
+    if (modo_splay_) {
+        raiz_ = splay(raiz_, clave_busqueda, INT_MIN, false, estadisticas_.busqueda_promedio);
+        Nodo* candidato = raiz_;
+        if (candidato && candidato->clave_promedio_cent < clave_busqueda) {
+            candidato = candidato->derecho;
+            while (candidato && candidato->izquierdo) {
+                ABB_REGISTRAR(++estadisticas_.busqueda_promedio.visitas);
+                candidato = candidato->izquierdo;
+            }
+        }
+        nodo_encontrado = (candidato && candidato->clave_promedio_cent == clave_busqueda) ? candidato : nullptr;
+        if (nodo_encontrado && nodo_encontrado != raiz_) {
+            raiz_ = splay(raiz_, clave_busqueda, nodo_encontrado->clave_id, false, estadisticas_.busqueda_promedio);
+        }
+    }
+    else {
+        nodo_encontrado = buscar_primero_por_promedio(raiz_, clave_busqueda);
+    }
+    ABB_REGISTRAR(registrar_profundidad(estadisticas_, estadisticas_.busqueda_promedio.visitas - visitas_previas));
     return nodo_encontrado ? &nodo_encontrado->dato : nullptr;
 }
 
 /**
  * @brief Busca un nodo por ID de manera recursiva.
- * @param nodo Raz del subrbol donde se realizar la bsqueda.
+ * @param nodo Raíz del subárbol donde se realizará la búsqueda.
  * @param id ID del estudiante a buscar.
  * @return Puntero al nodo encontrado o nullptr si no se encuentra.
- * @warning El rbol no est ordenado por ID, por lo que esta funcin
- *          puede llegar a recorrer todos los nodos del rbol.
+ * @warning El árbol no está ordenado por ID, por lo que esta función
+ *          puede llegar a recorrer todos los nodos del árbol.
  */
 ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::buscar_por_id_recursivo(Nodo* nodo, int id) {
     if (nodo == nullptr) return nullptr;
+    ABB_REGISTRAR(++estadisticas_.busqueda_id.visitas);
+    ABB_REGISTRAR(++estadisticas_.busqueda_id.comparaciones);
     if (nodo->dato.id() == id) return nodo;
 
     Nodo* resultado_izquierdo = buscar_por_id_recursivo(nodo->izquierdo, id);
@@ -175,79 +968,742 @@ ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::buscar_por_id_recursivo(Nodo*
  * @return Puntero constante al estudiante si se encuentra, nullptr en caso contrario.
  */
 const Estudiante* ArbolBinarioBusqueda::buscar_por_id(int id) {
+    ABB_REGISTRAR(++estadisticas_.busqueda_id.llamadas);
+    if (filtro_ids_ && !filtro_ids_->puede_contener(static_cast<uint32_t>(id))) return nullptr;
     Nodo* nodo_encontrado = buscar_por_id_recursivo(raiz_, id);
+    if (modo_splay_ && nodo_encontrado != nullptr) {
+        // Ya se conoce la clave completa: el siguiente acceso al mismo ID lo encuentra en la raíz.
+        raiz_ = splay(raiz_, nodo_encontrado->clave_promedio_cent, nodo_encontrado->clave_id, false, estadisticas_.busqueda_id);
+    }
     return nodo_encontrado ? &nodo_encontrado->dato : nullptr;
 }
 
-// ---------- Recorridos recursivos (pblicos) ----------
+// ---------- División / unión ----------
 
 /**
- * @brief Recorre el rbol en preorden de forma recursiva (interfaz pblica).
- * @param visitar Funcin callback que se aplica a cada estudiante visitado.
+ * @brief Separa un subárbol por una clave de promedio.
+ * @param nodo Raíz del subárbol.
+ * @param clave_promedio_cent Clave de corte en centésimas.
+ * @return (menores, mayores o iguales).
  * @details
- * En preorden se visita primero el nodo actual, luego el subrbol izquierdo
- * y al final el subrbol derecho.
+ * Si el nodo queda del lado "mayor o igual", su subárbol derecho ya está
+ * completo y solo hay que separar el izquierdo; el caso opuesto es simétrico.
+ */
+pair<ArbolBinarioBusqueda::Nodo*, ArbolBinarioBusqueda::Nodo*> ArbolBinarioBusqueda::dividir_recursivo(Nodo* nodo, int clave_promedio_cent) {
+    if (nodo == nullptr) return { nullptr, nullptr };
+    if (nodo->clave_promedio_cent >= clave_promedio_cent) {
+        pair<Nodo*, Nodo*> partes = dividir_recursivo(nodo->izquierdo, clave_promedio_cent);
+        nodo->izquierdo = partes.second;
+        recalcular_agregados(nodo);
+        return { partes.first, nodo };
+    }
+    pair<Nodo*, Nodo*> partes = dividir_recursivo(nodo->derecho, clave_promedio_cent);
+    nodo->derecho = partes.first;
+    recalcular_agregados(nodo);
+    return { nodo, partes.second };
+}
+
+/**
+ * @brief Desconecta el nodo de mayor clave.
+ * @param nodo Raíz del subárbol.
+ * @param maximo Nodo desconectado.
+ * @return Nueva raíz del subárbol.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::extraer_maximo(Nodo* nodo, Nodo*& maximo) {
+    if (nodo->derecho == nullptr) {
+        maximo = nodo;
+        Nodo* resto = nodo->izquierdo;
+        nodo->izquierdo = nullptr;
+        recalcular_agregados(nodo);
+        return resto;
+    }
+    nodo->derecho = extraer_maximo(nodo->derecho, maximo);
+    recalcular_agregados(nodo);
+    return nodo;
+}
+
+/**
+ * @brief Desconecta el nodo de menor clave.
+ * @param nodo Raíz del subárbol.
+ * @param minimo Nodo desconectado.
+ * @return Nueva raíz del subárbol.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::extraer_minimo(Nodo* nodo, Nodo*& minimo) {
+    if (nodo->izquierdo == nullptr) {
+        minimo = nodo;
+        Nodo* resto = nodo->derecho;
+        nodo->derecho = nullptr;
+        recalcular_agregados(nodo);
+        return resto;
+    }
+    nodo->izquierdo = extraer_minimo(nodo->izquierdo, minimo);
+    recalcular_agregados(nodo);
+    return nodo;
+}
+
+/**
+ * @brief Inserta un nodo existente en el subárbol.
+ * @param nodo Raíz del subárbol.
+ * @param nuevo Nodo suelto a enlazar.
+ * @return Nueva raíz del subárbol.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::enlazar_nodo(Nodo* nodo, Nodo* nuevo) {
+    if (nodo == nullptr) return nuevo;
+    const int comparacion = comparar_claves(nuevo->clave_promedio_cent, nuevo->clave_id, nodo->clave_promedio_cent, nodo->clave_id);
+    if (comparacion < 0) {
+        nodo->izquierdo = enlazar_nodo(nodo->izquierdo, nuevo);
+    }
+    else if (comparacion > 0) {
+        nodo->derecho = enlazar_nodo(nodo->derecho, nuevo);
+    }
+    else {
+        nodo->dato = std::move(nuevo->dato); // misma clave: actualiza
+#ifdef ABB_MERKLE
+        nodo->hash_dato = nuevo->hash_dato;
+#endif
+        liberar_nodo(nuevo);
+    }
+    recalcular_agregados(nodo);
+    return nodo;
+}
+
+/**
+ * @brief Reparte los nodos del árbol según un promedio de corte.
+ * @param promedio Promedio de corte.
+ * @param menores Árbol destino de las claves menores.
+ * @param mayores_o_iguales Árbol destino de las claves mayores o iguales.
+ * @details
+ * La raíz se desconecta antes de liberar los destinos, de modo que la
+ * operación es correcta aunque alguno de ellos sea este mismo árbol. Dos
+ * destinos iguales se rechazan antes de tocar nada: la segunda mitad
+ * pisaría a la primera y sus nodos quedarían sin dueño.
+ * @throws std::invalid_argument si ambos destinos son el mismo árbol.
+ */
+void ArbolBinarioBusqueda::dividir(double promedio, ArbolBinarioBusqueda& menores, ArbolBinarioBusqueda& mayores_o_iguales) {
+    if (&menores == &mayores_o_iguales) throw invalid_argument("ArbolBinarioBusqueda::dividir: los árboles destino deben ser distintos");
+    invalidar_indices();
+    menores.invalidar_indices();
+    mayores_o_iguales.invalidar_indices();
+    Nodo* raiz = raiz_;
+    raiz_ = nullptr;
+    vector<shared_ptr<void>> bloques = std::move(bloques_);
+    bloques_.clear();
+    pair<Nodo*, Nodo*> partes = dividir_recursivo(raiz, convertir_promedio_a_clave(promedio));
+
+    liberar_postorden(menores.raiz_);
+    menores.raiz_ = partes.first;
+    menores.bloques_ = bloques;
+    liberar_postorden(mayores_o_iguales.raiz_);
+    mayores_o_iguales.raiz_ = partes.second;
+    mayores_o_iguales.bloques_ = std::move(bloques);
+
+    reconstruir_filtro_ids();
+    menores.reconstruir_filtro_ids();
+    mayores_o_iguales.reconstruir_filtro_ids();
+}
+
+/**
+ * @brief Incorpora todos los nodos de otro árbol.
+ * @param otro Árbol de origen; queda vacío.
+ * @details
+ * Compara la clave máxima de un árbol con la mínima del otro. Si no se
+ * solapan, el nodo frontera (máximo del menor o mínimo del mayor) pasa a ser
+ * la raíz con ambos árboles como hijos. Si se solapan, los nodos de otro se
+ * desarman en postorden y se enlazan uno a uno con enlazar_nodo.
+ */
+void ArbolBinarioBusqueda::unir(ArbolBinarioBusqueda& otro) {
+    if (&otro == this || otro.raiz_ == nullptr) return;
+    invalidar_indices();
+    otro.invalidar_indices();
+    Nodo* ajeno = otro.raiz_;
+    otro.raiz_ = nullptr;
+    agregar_ids_al_filtro(ajeno);
+    otro.reconstruir_filtro_ids();
+    for (shared_ptr<void>& bloque : otro.bloques_) bloques_.push_back(std::move(bloque));
+    otro.bloques_.clear();
+    if (raiz_ == nullptr) { raiz_ = ajeno; return; }
+
+    Nodo* maximo_propio = raiz_;
+    while (maximo_propio->derecho) maximo_propio = maximo_propio->derecho;
+    Nodo* minimo_propio = raiz_;
+    while (minimo_propio->izquierdo) minimo_propio = minimo_propio->izquierdo;
+    Nodo* maximo_ajeno = ajeno;
+    while (maximo_ajeno->derecho) maximo_ajeno = maximo_ajeno->derecho;
+    Nodo* minimo_ajeno = ajeno;
+    while (minimo_ajeno->izquierdo) minimo_ajeno = minimo_ajeno->izquierdo;
+
+    if (comparar_claves(maximo_propio->clave_promedio_cent, maximo_propio->clave_id,
+        minimo_ajeno->clave_promedio_cent, minimo_ajeno->clave_id) < 0) {
+        Nodo* frontera = nullptr;
+        Nodo* resto = extraer_maximo(raiz_, frontera);
+        frontera->izquierdo = resto;
+        frontera->derecho = ajeno;
+        recalcular_agregados(frontera);
+        raiz_ = frontera;
+        return;
+    }
+    if (comparar_claves(maximo_ajeno->clave_promedio_cent, maximo_ajeno->clave_id,
+        minimo_propio->clave_promedio_cent, minimo_propio->clave_id) < 0) {
+        Nodo* frontera = nullptr;
+        Nodo* resto = extraer_minimo(raiz_, frontera);
+        frontera->izquierdo = ajeno;
+        frontera->derecho = resto;
+        recalcular_agregados(frontera);
+        raiz_ = frontera;
+        return;
+    }
+
+    // Rangos solapados: se desarma el otro árbol y se enlaza nodo por nodo.
+    stack<Nodo*> pendientes;
+    pendientes.push(ajeno);
+    while (!pendientes.empty()) {
+        Nodo* nodo_actual = pendientes.top(); pendientes.pop();
+        if (nodo_actual->izquierdo) pendientes.push(nodo_actual->izquierdo);
+        if (nodo_actual->derecho) pendientes.push(nodo_actual->derecho);
+        nodo_actual->izquierdo = nullptr;
+        nodo_actual->derecho = nullptr;
+        recalcular_agregados(nodo_actual);
+        raiz_ = enlazar_nodo(raiz_, nodo_actual);
+    }
+}
+
+// ---------- Operaciones de conjuntos ----------
+
+/**
+ * @brief Inorden iterativo que guarda los nodos.
+ * @param nodo Raíz del subárbol.
+ * @param salida Vector de salida.
+ */
+void ArbolBinarioBusqueda::recolectar_inorden(const Nodo* nodo, vector<const Nodo*>& salida) {
+    stack<const Nodo*> pila_nodos;
+    while (nodo != nullptr || !pila_nodos.empty()) {
+        while (nodo != nullptr) { pila_nodos.push(nodo); nodo = nodo->izquierdo; }
+        nodo = pila_nodos.top(); pila_nodos.pop();
+        salida.push_back(nodo);
+        nodo = nodo->derecho;
+    }
+}
+
+/**
+ * @brief Construcción balanceada en preorden dentro del bloque.
+ * @param inicio Nodos fuente ordenados.
+ * @param cantidad Cantidad de nodos fuente.
+ * @param bloque Bloque destino.
+ * @param posicion Posición de la raíz en el bloque.
+ * @return Raíz construida.
+ */
+ArbolBinarioBusqueda::Nodo* ArbolBinarioBusqueda::construir_balanceado(const Nodo* const* inicio, size_t cantidad, Nodo* bloque, size_t posicion) {
+    if (cantidad == 0) return nullptr;
+    const size_t mitad = cantidad / 2;
+    Nodo* nodo = ::new (static_cast<void*>(bloque + posicion)) Nodo(Estudiante(inicio[mitad]->dato));
+    nodo->en_bloque = true;
+    try {
+        nodo->izquierdo = construir_balanceado(inicio, mitad, bloque, posicion + 1);
+        nodo->derecho = construir_balanceado(inicio + mitad + 1, cantidad - mitad - 1, bloque, posicion + 1 + mitad);
+    }
+    catch (...) {
+        // Mismo criterio que clonar_recursivo: no dejar cadenas vivas en el bloque.
+        liberar_postorden(nodo->izquierdo);
+        nodo->~Nodo();
+        throw;
+    }
+    recalcular_agregados(nodo);
+    return nodo;
+}
+
+/**
+ * @brief Mezcla de dos inorden con selección por pertenencia de ID.
+ * @param a Primer árbol.
+ * @param b Segundo árbol.
+ * @param solo_a Incluir estudiantes cuyo ID solo está en a.
+ * @param en_ambos Incluir los de a cuyo ID también está en b.
+ * @param solo_b Incluir estudiantes cuyo ID solo está en b.
+ * @return Árbol resultante.
+ * @details
+ * La pertenencia se consulta con búsqueda binaria sobre los IDs ordenados
+ * del otro árbol; cada inorden se filtra sin perder su orden por clave y
+ * los dos filtrados se mezclan como en merge sort. Un mismo ID no puede
+ * quedar seleccionado de ambos lados, así que la mezcla no ve claves iguales.
+ */
+ArbolBinarioBusqueda ArbolBinarioBusqueda::combinar(const ArbolBinarioBusqueda& a, const ArbolBinarioBusqueda& b,
+    bool solo_a, bool en_ambos, bool solo_b) {
+    vector<const Nodo*> nodos_a, nodos_b, seleccion;
+    nodos_a.reserve(static_cast<size_t>(a.contar_nodos()));
+    nodos_b.reserve(static_cast<size_t>(b.contar_nodos()));
+    recolectar_inorden(a.raiz_, nodos_a);
+    recolectar_inorden(b.raiz_, nodos_b);
+
+    // Filtrado de cada lado según si su ID aparece en el otro árbol.
+    auto ids_ordenados = [](const vector<const Nodo*>& nodos) {
+        vector<int> ids;
+        ids.reserve(nodos.size());
+        for (const Nodo* nodo : nodos) ids.push_back(nodo->clave_id);
+        sort(ids.begin(), ids.end());
+        return ids;
+    };
+    vector<const Nodo*> elegidos_a, elegidos_b;
+    if (solo_a || en_ambos) {
+        const vector<int> ids_b = ids_ordenados(nodos_b);
+        for (const Nodo* nodo : nodos_a) {
+            const bool en_b = binary_search(ids_b.begin(), ids_b.end(), nodo->clave_id);
+            if (en_b ? en_ambos : solo_a) elegidos_a.push_back(nodo);
+        }
+    }
+    if (solo_b) {
+        const vector<int> ids_a = ids_ordenados(nodos_a);
+        for (const Nodo* nodo : nodos_b) {
+            if (!binary_search(ids_a.begin(), ids_a.end(), nodo->clave_id)) elegidos_b.push_back(nodo);
+        }
+    }
+
+    seleccion.reserve(elegidos_a.size() + elegidos_b.size());
+    size_t indice_a = 0, indice_b = 0;
+    while (indice_a < elegidos_a.size() && indice_b < elegidos_b.size()) {
+        const Nodo* nodo_a = elegidos_a[indice_a];
+        const Nodo* nodo_b = elegidos_b[indice_b];
+        if (comparar_claves(nodo_a->clave_promedio_cent, nodo_a->clave_id, nodo_b->clave_promedio_cent, nodo_b->clave_id) < 0) {
+            seleccion.push_back(nodo_a);
+            ++indice_a;
+        }
+        else {
+            seleccion.push_back(nodo_b);
+            ++indice_b;
+        }
+    }
+    seleccion.insert(seleccion.end(), elegidos_a.begin() + indice_a, elegidos_a.end());
+    seleccion.insert(seleccion.end(), elegidos_b.begin() + indice_b, elegidos_b.end());
+
+    ArbolBinarioBusqueda resultado;
+    if (seleccion.empty()) return resultado;
+    resultado.bloques_.push_back(shared_ptr<void>(::operator new(seleccion.size() * sizeof(Nodo)), [](void* memoria) { ::operator delete(memoria); }));
+    resultado.raiz_ = construir_balanceado(seleccion.data(), seleccion.size(), static_cast<Nodo*>(resultado.bloques_.back().get()), 0);
+    return resultado;
+}
+
+/**
+ * @brief Unión por ID.
+ * @param a Primer árbol.
+ * @param b Segundo árbol.
+ * @return Estudiantes de a o de b; si el ID está en ambos, el de a.
+ */
+ArbolBinarioBusqueda ArbolBinarioBusqueda::union_conjuntos(const ArbolBinarioBusqueda& a, const ArbolBinarioBusqueda& b) {
+    return combinar(a, b, true, true, true);
+}
+
+/**
+ * @brief Intersección por ID.
+ * @param a Primer árbol.
+ * @param b Segundo árbol.
+ * @return Estudiantes de a cuyo ID también está en b.
+ */
+ArbolBinarioBusqueda ArbolBinarioBusqueda::interseccion(const ArbolBinarioBusqueda& a, const ArbolBinarioBusqueda& b) {
+    return combinar(a, b, false, true, false);
+}
+
+/**
+ * @brief Diferencia por ID.
+ * @param a Árbol base.
+ * @param b Árbol a descontar.
+ * @return Estudiantes de a cuyo ID no está en b.
+ */
+ArbolBinarioBusqueda ArbolBinarioBusqueda::diferencia(const ArbolBinarioBusqueda& a, const ArbolBinarioBusqueda& b) {
+    return combinar(a, b, true, false, false);
+}
+
+#ifdef ABB_MERKLE
+// ---------- Hashes Merkle ----------
+
+/**
+ * @brief Mezcla final de splitmix64: dispersa todos los bits de la entrada.
+ * @param valor Valor a mezclar.
+ * @return Valor mezclado.
+ */
+static uint64_t mezclar_hash(uint64_t valor) {
+    valor ^= valor >> 30;
+    valor *= 0xBF58476D1CE4E5B9ULL;
+    valor ^= valor >> 27;
+    valor *= 0x94D049BB133111EBULL;
+    valor ^= valor >> 31;
+    return valor;
+}
+
+/**
+ * @brief Acumula una cadena con FNV-1a de 64 bits.
+ * @param hash Estado previo.
+ * @param texto Bytes a acumular.
+ * @return Nuevo estado.
+ */
+static uint64_t acumular_fnv1a(uint64_t hash, string_view texto) {
+    for (unsigned char caracter : texto) {
+        hash ^= caracter;
+        hash *= 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/**
+ * @brief Hash del contenido de un estudiante.
+ * @param estudiante Estudiante a resumir.
+ * @return Hash de 64 bits.
+ * @details
+ * Nombre y carrera se acumulan con FNV-1a, separados por su longitud para
+ * que ("ab", "c") y ("a", "bc") no coincidan; el ID y los bits exactos del
+ * promedio se mezclan aparte. El resultado final pasa por mezclar_hash para
+ * que la suma de los hashes de un subárbol se comporte como aleatoria.
+ */
+uint64_t ArbolBinarioBusqueda::hash_estudiante(const Estudiante& estudiante) {
+    uint64_t hash = 0xCBF29CE484222325ULL;
+    hash = acumular_fnv1a(hash, estudiante.nombre());
+    hash = mezclar_hash(hash ^ estudiante.nombre().size());
+    hash = acumular_fnv1a(hash, estudiante.carrera());
+    hash = mezclar_hash(hash ^ estudiante.carrera().size());
+
+    const double promedio = estudiante.promedio();
+    uint64_t bits_promedio;
+    memcpy(&bits_promedio, &promedio, sizeof(bits_promedio));
+    hash = mezclar_hash(hash ^ static_cast<uint32_t>(estudiante.id()));
+    return mezclar_hash(hash ^ bits_promedio);
+}
+
+/**
+ * @brief Hash de todo el árbol.
+ * @return Hash del subárbol de la raíz, o 0 si está vacío.
+ */
+uint64_t ArbolBinarioBusqueda::hash_raiz() const { return raiz_ ? raiz_->hash_subarbol : 0; }
+
+/**
+ * @brief Diferencias entre dos subárboles del mismo rango de claves.
+ * @param propio Subárbol propio.
+ * @param ajeno Subárbol ajeno.
+ * @param visitar Callback de diferencias.
+ * @details
+ * Si las raíces tienen la misma clave, sus hijos izquierdos cubren el mismo
+ * rango (y también los derechos), así que se comparan por pares. Si no, se
+ * recolectan ambos inorden y se mezclan como en las operaciones de conjuntos.
+ */
+void ArbolBinarioBusqueda::diferencias_recursivo(const Nodo* propio, const Nodo* ajeno,
+    const function<void(const Estudiante*, const Estudiante*)>& visitar) {
+    const uint64_t hash_propio = propio ? propio->hash_subarbol : 0;
+    const uint64_t hash_ajeno = ajeno ? ajeno->hash_subarbol : 0;
+    if (hash_propio == hash_ajeno) return;
+
+    if (propio && ajeno && propio->clave_promedio_cent == ajeno->clave_promedio_cent && propio->clave_id == ajeno->clave_id) {
+        diferencias_recursivo(propio->izquierdo, ajeno->izquierdo, visitar);
+        if (propio->hash_dato != ajeno->hash_dato) visitar(&propio->dato, &ajeno->dato);
+        diferencias_recursivo(propio->derecho, ajeno->derecho, visitar);
+        return;
+    }
+
+    vector<const Nodo*> nodos_propios, nodos_ajenos;
+    recolectar_inorden(propio, nodos_propios);
+    recolectar_inorden(ajeno, nodos_ajenos);
+    size_t indice_propio = 0, indice_ajeno = 0;
+    while (indice_propio < nodos_propios.size() || indice_ajeno < nodos_ajenos.size()) {
+        if (indice_ajeno == nodos_ajenos.size()) { visitar(&nodos_propios[indice_propio++]->dato, nullptr); continue; }
+        if (indice_propio == nodos_propios.size()) { visitar(nullptr, &nodos_ajenos[indice_ajeno++]->dato); continue; }
+
+        const Nodo* nodo_propio = nodos_propios[indice_propio];
+        const Nodo* nodo_ajeno = nodos_ajenos[indice_ajeno];
+        const int comparacion = comparar_claves(nodo_propio->clave_promedio_cent, nodo_propio->clave_id,
+            nodo_ajeno->clave_promedio_cent, nodo_ajeno->clave_id);
+        if (comparacion < 0) { visitar(&nodo_propio->dato, nullptr); ++indice_propio; }
+        else if (comparacion > 0) { visitar(nullptr, &nodo_ajeno->dato); ++indice_ajeno; }
+        else {
+            if (nodo_propio->hash_dato != nodo_ajeno->hash_dato) visitar(&nodo_propio->dato, &nodo_ajeno->dato);
+            ++indice_propio;
+            ++indice_ajeno;
+        }
+    }
+}
+
+/**
+ * @brief Diferencias entre este árbol y otro.
+ * @param otro Árbol a comparar.
+ * @param visitar Callback (propio, ajeno).
+ */
+void ArbolBinarioBusqueda::diferencias(const ArbolBinarioBusqueda& otro,
+    const function<void(const Estudiante*, const Estudiante*)>& visitar) const {
+    diferencias_recursivo(raiz_, otro.raiz_, visitar);
+}
+#endif
+
+// ---------- Búsquedas por lote ----------
+
+/**
+ * @brief Resuelve un rango ordenado de sondas sobre el subárbol dado.
+ * @param nodo Raíz del subárbol actual.
+ * @param inicio Primera sonda del rango (ordenadas por clave).
+ * @param fin Posición siguiente a la última sonda.
+ * @param resultados Resultados indexados por posición original de la sonda.
+ * @details
+ * Separa las sondas en menores, iguales y mayores a la clave del nodo con dos
+ * búsquedas binarias. Las iguales toman este nodo y bajan también por la
+ * izquierda: cada coincidencia posterior tiene un ID menor y la reemplaza,
+ * de modo que queda la misma respuesta que buscar_por_promedio. Antes de
+ * descender se precargan los hijos que tengan sondas pendientes, de modo que
+ * la lectura de ambas ramas se solapa.
+ */
+void ArbolBinarioBusqueda::buscar_lote_recursivo(Nodo* nodo, const pair<int, size_t>* inicio, const pair<int, size_t>* fin,
+    vector<const Estudiante*>& resultados) {
+    if (nodo == nullptr || inicio == fin) return;
+    ABB_REGISTRAR(++estadisticas_.busqueda_promedio.visitas);
+
+    const int clave_nodo = nodo->clave_promedio_cent;
+    const pair<int, size_t>* primero_igual = lower_bound(inicio, fin, clave_nodo,
+        [](const pair<int, size_t>& sonda, int clave) { return sonda.first < clave; });
+    const pair<int, size_t>* primero_mayor = upper_bound(primero_igual, fin, clave_nodo,
+        [](int clave, const pair<int, size_t>& sonda) { return clave < sonda.first; });
+
+    if (inicio != primero_mayor && nodo->izquierdo) ABB_PRECARGAR(nodo->izquierdo);
+    if (primero_mayor != fin && nodo->derecho) ABB_PRECARGAR(nodo->derecho);
+
+    for (const pair<int, size_t>* sonda = primero_igual; sonda != primero_mayor; ++sonda) {
+        resultados[sonda->second] = &nodo->dato;
+    }
+    buscar_lote_recursivo(nodo->izquierdo, inicio, primero_mayor, resultados);
+    buscar_lote_recursivo(nodo->derecho, primero_mayor, fin, resultados);
+}
+
+/**
+ * @brief Busca un lote de promedios en un único descenso coordinado.
+ * @param promedios Promedios a buscar.
+ * @return Estudiante encontrado (o nullptr) para cada promedio, en el orden de entrada.
+ * @details
+ * Convierte cada promedio a centésimas, ordena las sondas conservando su
+ * posición original y las resuelve con buscar_lote_recursivo. Con el árbol
+ * congelado, cada sonda se resuelve en el índice aprendido sin ordenar.
+ */
+vector<const Estudiante*> ArbolBinarioBusqueda::buscar_lote(span<const double> promedios) {
+    vector<const Estudiante*> resultados(promedios.size(), nullptr);
+    vector<pair<int, size_t>> sondas;
+    sondas.reserve(promedios.size());
+    for (size_t indice = 0; indice < promedios.size(); ++indice) {
+        sondas.push_back({ convertir_promedio_a_clave(promedios[indice]), indice });
+    }
+    ABB_REGISTRAR(estadisticas_.busqueda_promedio.llamadas += promedios.size());
+    if (indice_aprendido_.valido) {
+        for (const pair<int, size_t>& sonda : sondas) {
+            const size_t posicion = posicion_aprendida(sonda.first, INT_MIN, false, &estadisticas_.busqueda_promedio);
+            if (posicion < indice_aprendido_.entradas.size() && indice_aprendido_.entradas[posicion].clave_promedio_cent == sonda.first) {
+                resultados[sonda.second] = indice_aprendido_.entradas[posicion].estudiante;
+            }
+        }
+        return resultados;
+    }
+    sort(sondas.begin(), sondas.end());
+
+    buscar_lote_recursivo(raiz_, sondas.data(), sondas.data() + sondas.size(), resultados);
+    return resultados;
+}
+
+/**
+ * @brief Busca un lote de IDs con un único recorrido en preorden.
+ * @param ids IDs a buscar.
+ * @return Estudiante encontrado (o nullptr) para cada ID, en el orden de entrada.
+ * @details
+ * Agrupa las posiciones de cada ID en una tabla hash y recorre el árbol en
+ * preorden iterativo (el mismo orden que buscar_por_id), asignando el primer
+ * estudiante que coincide con cada ID. El recorrido termina en cuanto no
+ * quedan IDs pendientes.
+ */
+vector<const Estudiante*> ArbolBinarioBusqueda::buscar_lote_por_id(span<const int> ids) {
+    vector<const Estudiante*> resultados(ids.size(), nullptr);
+    unordered_map<int, vector<size_t>> pendientes;
+    pendientes.reserve(ids.size());
+    for (size_t indice = 0; indice < ids.size(); ++indice) {
+        if (filtro_ids_ && !filtro_ids_->puede_contener(static_cast<uint32_t>(ids[indice]))) continue;
+        pendientes[ids[indice]].push_back(indice);
+    }
+    ABB_REGISTRAR(estadisticas_.busqueda_id.llamadas += ids.size());
+
+    if (raiz_ == nullptr) return resultados;
+    stack<Nodo*> pila_nodos;
+    pila_nodos.push(raiz_);
+    while (!pila_nodos.empty() && !pendientes.empty()) {
+        Nodo* nodo_actual = pila_nodos.top(); pila_nodos.pop();
+        ABB_REGISTRAR(++estadisticas_.busqueda_id.visitas);
+        ABB_REGISTRAR(++estadisticas_.busqueda_id.comparaciones);
+
+        auto encontrado = pendientes.find(nodo_actual->dato.id());
+        if (encontrado != pendientes.end()) {
+            for (size_t posicion : encontrado->second) resultados[posicion] = &nodo_actual->dato;
+            pendientes.erase(encontrado);
+        }
+        if (nodo_actual->derecho) pila_nodos.push(nodo_actual->derecho);
+        if (nodo_actual->izquierdo) pila_nodos.push(nodo_actual->izquierdo);
+    }
+    return resultados;
+}
+
+/**
+ * @brief Busca por prefijo de nombre en el índice radix.
+ * @param prefijo Prefijo buscado.
+ * @param limite Máximo de resultados.
+ * @return Estudiantes cuyo nombre empieza con el prefijo.
+ * @details
+ * Si el índice no existe, lo construye agregando los nodos en inorden.
+ */
+vector<const Estudiante*> ArbolBinarioBusqueda::buscar_por_prefijo(string_view prefijo, size_t limite) {
+    if (!indice_nombres_) {
+        indice_nombres_ = make_unique<IndiceNombres>();
+        vector<const Nodo*> nodos;
+        nodos.reserve(raiz_ ? static_cast<size_t>(raiz_->cantidad_subarbol) : 0);
+        recolectar_inorden(raiz_, nodos);
+        for (const Nodo* nodo : nodos) indice_nombres_->insertar(&nodo->dato);
+    }
+    vector<const Estudiante*> resultados;
+    indice_nombres_->buscar_prefijo(prefijo, limite, [&resultados](const Estudiante& estudiante) { resultados.push_back(&estudiante); });
+    return resultados;
+}
+
+// ---------- Consultas por carrera ----------
+
+/**
+ * @brief Construye el índice por carrera a partir del inorden.
+ * @details
+ * El inorden ya viene ordenado por (promedio, ID); un ordenamiento estable
+ * por código de carrera deja las claves en el orden del mapa, y cada una se
+ * inserta con la pista end() en O(1) amortizado.
+ */
+void ArbolBinarioBusqueda::preparar_indice_carreras() {
+    if (indice_carreras_) return;
+    vector<const Nodo*> nodos;
+    nodos.reserve(raiz_ ? static_cast<size_t>(raiz_->cantidad_subarbol) : 0);
+    recolectar_inorden(raiz_, nodos);
+    stable_sort(nodos.begin(), nodos.end(), [](const Nodo* a, const Nodo* b) {
+        return a->dato.codigo_carrera() < b->dato.codigo_carrera();
+        });
+
+    indice_carreras_ = make_unique<map<ClaveCarrera, const Estudiante*>>();
+    for (const Nodo* nodo : nodos) {
+        indice_carreras_->emplace_hint(indice_carreras_->end(),
+            ClaveCarrera{ nodo->dato.codigo_carrera(), nodo->clave_promedio_cent, nodo->clave_id }, &nodo->dato);
+    }
+}
+
+/**
+ * @brief Rango de promedios dentro de una carrera.
+ * @param carrera Carrera buscada.
+ * @param minimo Promedio mínimo.
+ * @param maximo Promedio máximo.
+ * @param visitar Función callback para cada estudiante.
+ * @details
+ * Se ubica con lower_bound en (carrera, mínimo, INT_MIN) y avanza mientras
+ * la clave siga en la carrera y no pase del máximo.
+ */
+void ArbolBinarioBusqueda::rango_por_carrera(string_view carrera, double minimo, double maximo,
+    const function<void(const Estudiante&)>& visitar) {
+    const optional<uint16_t> codigo = DiccionarioCadenas::carreras().buscar_codigo(carrera);
+    if (!codigo) return;
+    const int clave_minima = convertir_promedio_a_clave(minimo);
+    const int clave_maxima = convertir_promedio_a_clave(maximo);
+    if (clave_minima > clave_maxima) return;
+
+    preparar_indice_carreras();
+    for (auto entrada = indice_carreras_->lower_bound(ClaveCarrera{ *codigo, clave_minima, INT_MIN });
+        entrada != indice_carreras_->end() && entrada->first.codigo_carrera == *codigo && entrada->first.clave_promedio_cent <= clave_maxima;
+        ++entrada) {
+        visitar(*entrada->second);
+    }
+}
+
+/**
+ * @brief Mejores k de una carrera.
+ * @param carrera Carrera buscada.
+ * @param k Cantidad máxima.
+ * @param visitar Función callback para cada estudiante.
+ * @details
+ * Parte de la primera clave posterior a la carrera y retrocede.
+ */
+void ArbolBinarioBusqueda::top_k_por_carrera(string_view carrera, int k, const function<void(const Estudiante&)>& visitar) {
+    const optional<uint16_t> codigo = DiccionarioCadenas::carreras().buscar_codigo(carrera);
+    if (!codigo || k <= 0) return;
+
+    preparar_indice_carreras();
+    auto entrada = indice_carreras_->upper_bound(ClaveCarrera{ *codigo, INT_MAX, INT_MAX });
+    while (k > 0 && entrada != indice_carreras_->begin()) {
+        --entrada;
+        if (entrada->first.codigo_carrera != *codigo) break;
+        visitar(*entrada->second);
+        --k;
+    }
+}
+
+// ---------- Recorridos recursivos (públicos) ----------
+
+/**
+ * @brief Recorre el árbol en preorden de forma recursiva (interfaz pública).
+ * @param visitar Función callback que se aplica a cada estudiante visitado.
+ * @details
+ * En preorden se visita primero el nodo actual, luego el subárbol izquierdo
+ * y al final el subárbol derecho.
  */
 void ArbolBinarioBusqueda::preorden_rec(const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
     preorden_recursivo(raiz_, visitar);
 }
 
 /**
- * @brief Recorre el rbol en inorden de forma recursiva (interfaz pblica).
- * @param visitar Funcin callback que se aplica a cada estudiante visitado.
+ * @brief Recorre el árbol en inorden de forma recursiva (interfaz pública).
+ * @param visitar Función callback que se aplica a cada estudiante visitado.
  * @details
- * En inorden se visita primero el subrbol izquierdo, luego el nodo actual
- * y al final el subrbol derecho, obteniendo los datos en orden ascendente
- * segn la clave.
+ * En inorden se visita primero el subárbol izquierdo, luego el nodo actual
+ * y al final el subárbol derecho, obteniendo los datos en orden ascendente
+ * según la clave.
  */
 void ArbolBinarioBusqueda::inorden_rec(const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
     inorden_recursivo(raiz_, visitar);
 }
 
 /**
- * @brief Recorre el rbol en postorden de forma recursiva (interfaz pblica).
- * @param visitar Funcin callback que se aplica a cada estudiante visitado.
+ * @brief Recorre el árbol en postorden de forma recursiva (interfaz pública).
+ * @param visitar Función callback que se aplica a cada estudiante visitado.
  * @details
- * En postorden se visita primero el subrbol izquierdo, luego el derecho
- * y por ltimo el nodo actual.
+ * En postorden se visita primero el subárbol izquierdo, luego el derecho
+ * y por último el nodo actual.
  */
 void ArbolBinarioBusqueda::postorden_rec(const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
     postorden_recursivo(raiz_, visitar);
 }
 
 // ---------- Recorridos recursivos (privados) ----------
 
 /**
- * @brief Implementacin recursiva del recorrido en preorden.
- * @param nodo Nodo actual del subrbol.
- * @param visitar Funcin callback para procesar el dato del nodo.
+ * @brief Implementación recursiva del recorrido en preorden.
+ * @param nodo Nodo actual del subárbol.
+ * @param visitar Función callback para procesar el dato del nodo.
  */
-void ArbolBinarioBusqueda::preorden_recursivo(Nodo* nodo, const function<void(const Estudiante&)>& visitar) {
+void ArbolBinarioBusqueda::preorden_recursivo(Nodo* nodo, const function<void(const Estudiante&)>& visitar) const {
     if (nodo == nullptr) return;
+    ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
     visitar(nodo->dato);
     preorden_recursivo(nodo->izquierdo, visitar);
     preorden_recursivo(nodo->derecho, visitar);
 }
 
 /**
- * @brief Implementacin recursiva del recorrido en inorden.
- * @param nodo Nodo actual del subrbol.
- * @param visitar Funcin callback para procesar el dato del nodo.
+ * @brief Implementación recursiva del recorrido en inorden.
+ * @param nodo Nodo actual del subárbol.
+ * @param visitar Función callback para procesar el dato del nodo.
  */
-void ArbolBinarioBusqueda::inorden_recursivo(Nodo* nodo, const function<void(const Estudiante&)>& visitar) {
+void ArbolBinarioBusqueda::inorden_recursivo(Nodo* nodo, const function<void(const Estudiante&)>& visitar) const {
     if (nodo == nullptr) return;
+    ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
     inorden_recursivo(nodo->izquierdo, visitar);
     visitar(nodo->dato);
     inorden_recursivo(nodo->derecho, visitar);
 }
 
 /**
- * @brief Implementacin recursiva del recorrido en postorden.
- * @param nodo Nodo actual del subrbol.
- * @param visitar Funcin callback para procesar el dato del nodo.
+ * @brief Implementación recursiva del recorrido en postorden.
+ * @param nodo Nodo actual del subárbol.
+ * @param visitar Función callback para procesar el dato del nodo.
  */
-void ArbolBinarioBusqueda::postorden_recursivo(Nodo* nodo, const function<void(const Estudiante&)>& visitar) {
+void ArbolBinarioBusqueda::postorden_recursivo(Nodo* nodo, const function<void(const Estudiante&)>& visitar) const {
     if (nodo == nullptr) return;
+    ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
     postorden_recursivo(nodo->izquierdo, visitar);
     postorden_recursivo(nodo->derecho, visitar);
     visitar(nodo->dato);
@@ -256,19 +1712,21 @@ void ArbolBinarioBusqueda::postorden_recursivo(Nodo* nodo, const function<void(c
 // ---------- Recorridos iterativos ----------
 
 /**
- * @brief Recorre el rbol en preorden de forma iterativa.
- * @param visitar Funcin callback para procesar cada estudiante.
+ * @brief Recorre el árbol en preorden de forma iterativa.
+ * @param visitar Función callback para procesar cada estudiante.
  * @details
- * Utiliza una pila explcita en lugar de recursin. Se apilan primero
+ * Utiliza una pila explícita en lugar de recursión. Se apilan primero
  * los hijos derechos y luego los izquierdos, para respetar el orden
  * de visita (nodo, izquierdo, derecho).
  */
 void ArbolBinarioBusqueda::preorden_it(const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
     if (raiz_ == nullptr) return;
     stack<Nodo*> pila_nodos;
     pila_nodos.push(raiz_);
     while (!pila_nodos.empty()) {
         Nodo* nodo_actual = pila_nodos.top(); pila_nodos.pop();
+        ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
         visitar(nodo_actual->dato);
         if (nodo_actual->derecho) pila_nodos.push(nodo_actual->derecho);
         if (nodo_actual->izquierdo) pila_nodos.push(nodo_actual->izquierdo);
@@ -276,36 +1734,40 @@ void ArbolBinarioBusqueda::preorden_it(const function<void(const Estudiante&)>&
 }
 
 /**
- * @brief Recorre el rbol en inorden de forma iterativa.
- * @param visitar Funcin callback para procesar cada estudiante.
+ * @brief Recorre el árbol en inorden de forma iterativa.
+ * @param visitar Función callback para procesar cada estudiante.
  * @details
- * Emplea una pila para simular el comportamiento de la recursin, bajando
+ * Emplea una pila para simular el comportamiento de la recursión, bajando
  * por la izquierda hasta el fondo y luego retrocediendo por la derecha.
  */
 void ArbolBinarioBusqueda::inorden_it(const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
     stack<Nodo*> pila_nodos;
     Nodo* nodo_actual = raiz_;
     while (nodo_actual != nullptr || !pila_nodos.empty()) {
         while (nodo_actual != nullptr) { pila_nodos.push(nodo_actual); nodo_actual = nodo_actual->izquierdo; }
         nodo_actual = pila_nodos.top(); pila_nodos.pop();
+        ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
         visitar(nodo_actual->dato);
         nodo_actual = nodo_actual->derecho;
     }
 }
 
 /**
- * @brief Recorre el rbol en postorden de forma iterativa.
- * @param visitar Funcin callback para procesar cada estudiante.
+ * @brief Recorre el árbol en postorden de forma iterativa.
+ * @param visitar Función callback para procesar cada estudiante.
  * @details
  * Utiliza dos pilas: una para el recorrido inicial y otra para invertir
  * el orden de visita, obteniendo finalmente el orden postorden.
  */
 void ArbolBinarioBusqueda::postorden_it(const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
     if (raiz_ == nullptr) return;
     stack<Nodo*> pila_entrada, pila_salida;
     pila_entrada.push(raiz_);
     while (!pila_entrada.empty()) {
         Nodo* nodo_actual = pila_entrada.top(); pila_entrada.pop();
+        ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
         pila_salida.push(nodo_actual);
         if (nodo_actual->izquierdo) pila_entrada.push(nodo_actual->izquierdo);
         if (nodo_actual->derecho) pila_entrada.push(nodo_actual->derecho);
@@ -313,16 +1775,165 @@ void ArbolBinarioBusqueda::postorden_it(const function<void(const Estudiante&)>&
     while (!pila_salida.empty()) { visitar(pila_salida.top()->dato); pila_salida.pop(); }
 }
 
+// ---------- Recorridos parciales (top-K / bottom-K) ----------
+
+/**
+ * @brief Visita los k mayores promedios en orden descendente.
+ * @param k Cantidad de estudiantes a visitar.
+ * @param visitar Función callback para cada estudiante.
+ * @details
+ * Es el inorden iterativo con los hijos intercambiados: baja por la derecha
+ * apilando nodos y, al desapilar, visita y continúa por la izquierda. Solo
+ * se tocan la rama derecha inicial y los k nodos visitados.
+ */
+void ArbolBinarioBusqueda::top_k(int k, const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
+    stack<Nodo*> pila_nodos;
+    Nodo* nodo_actual = raiz_;
+    int visitados = 0;
+    while (visitados < k && (nodo_actual != nullptr || !pila_nodos.empty())) {
+        while (nodo_actual != nullptr) { pila_nodos.push(nodo_actual); nodo_actual = nodo_actual->derecho; }
+        nodo_actual = pila_nodos.top(); pila_nodos.pop();
+        ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
+        visitar(nodo_actual->dato);
+        ++visitados;
+        nodo_actual = nodo_actual->izquierdo;
+    }
+}
+
+/**
+ * @brief Visita los k menores promedios en orden ascendente.
+ * @param k Cantidad de estudiantes a visitar.
+ * @param visitar Función callback para cada estudiante.
+ * @details
+ * Igual que inorden_it, pero se detiene después de k visitas.
+ */
+void ArbolBinarioBusqueda::bottom_k(int k, const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
+    stack<Nodo*> pila_nodos;
+    Nodo* nodo_actual = raiz_;
+    int visitados = 0;
+    while (visitados < k && (nodo_actual != nullptr || !pila_nodos.empty())) {
+        while (nodo_actual != nullptr) { pila_nodos.push(nodo_actual); nodo_actual = nodo_actual->izquierdo; }
+        nodo_actual = pila_nodos.top(); pila_nodos.pop();
+        ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
+        visitar(nodo_actual->dato);
+        ++visitados;
+        nodo_actual = nodo_actual->derecho;
+    }
+}
+
+// ---------- Paginación ----------
+
+/**
+ * @brief Codifica el cursor como texto.
+ * @return "" para el inicio; si no, la clave y el id como dos enteros de 32 bits en hexadecimal.
+ */
+string CursorPagina::codificar() const {
+    if (al_inicio) return string();
+    static const char digitos[] = "0123456789abcdef";
+    const uint64_t valor = (static_cast<uint64_t>(static_cast<uint32_t>(clave_promedio_cent)) << 32) | static_cast<uint32_t>(id);
+    string texto(16, '0');
+    for (int indice = 15; indice >= 0; --indice) texto[static_cast<size_t>(indice)] = digitos[(valor >> (4 * (15 - indice))) & 0xF];
+    return texto;
+}
+
+/**
+ * @brief Decodifica un cursor producido por codificar().
+ * @param texto Texto del cliente.
+ * @return Cursor equivalente.
+ * @throws std::invalid_argument ante un largo o un carácter inválido.
+ */
+CursorPagina CursorPagina::decodificar(string_view texto) {
+    CursorPagina cursor;
+    if (texto.empty()) return cursor;
+    if (texto.size() != 16) throw invalid_argument("CursorPagina: cursor inválido");
+    uint64_t valor = 0;
+    for (char caracter : texto) {
+        int digito;
+        if (caracter >= '0' && caracter <= '9') digito = caracter - '0';
+        else if (caracter >= 'a' && caracter <= 'f') digito = caracter - 'a' + 10;
+        else if (caracter >= 'A' && caracter <= 'F') digito = caracter - 'A' + 10;
+        else throw invalid_argument("CursorPagina: cursor inválido");
+        valor = (valor << 4) | static_cast<uint64_t>(digito);
+    }
+    cursor.al_inicio = false;
+    cursor.clave_promedio_cent = static_cast<int>(static_cast<uint32_t>(valor >> 32));
+    cursor.id = static_cast<int>(static_cast<uint32_t>(valor));
+    return cursor;
+}
+
+/**
+ * @brief Visita la página que sigue al cursor.
+ * @param cursor Última clave entregada.
+ * @param n Tamaño de la página.
+ * @param visitar Función callback para cada estudiante.
+ * @return Cursor con la clave del último estudiante visitado.
+ * @details
+ * El descenso deja en la pila exactamente los nodos con clave mayor que el
+ * cursor en cuyo subárbol izquierdo se bajó, que es el estado del inorden
+ * iterativo justo después de la clave. Desde ahí continúa como bottom_k.
+ * Con el árbol congelado, la posición inicial la da el índice aprendido y
+ * la página se lee seguida del arreglo.
+ */
+CursorPagina ArbolBinarioBusqueda::siguiente_pagina(const CursorPagina& cursor, int n, const function<void(const Estudiante&)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
+    if (indice_aprendido_.valido) {
+        CursorPagina siguiente = cursor;
+        const size_t total = indice_aprendido_.entradas.size();
+        size_t posicion = cursor.al_inicio ? 0 : posicion_aprendida(cursor.clave_promedio_cent, cursor.id, true);
+        for (int visitados = 0; visitados < n && posicion < total; ++visitados, ++posicion) {
+            ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
+            const IndiceAprendido::Entrada& entrada = indice_aprendido_.entradas[posicion];
+            visitar(*entrada.estudiante);
+            siguiente.al_inicio = false;
+            siguiente.clave_promedio_cent = entrada.clave_promedio_cent;
+            siguiente.id = entrada.id;
+        }
+        return siguiente;
+    }
+
+    stack<Nodo*> pila_nodos;
+    Nodo* nodo_actual = raiz_;
+    if (!cursor.al_inicio) {
+        while (nodo_actual != nullptr) {
+            if (comparar_claves(nodo_actual->clave_promedio_cent, nodo_actual->clave_id, cursor.clave_promedio_cent, cursor.id) > 0) {
+                pila_nodos.push(nodo_actual);
+                nodo_actual = nodo_actual->izquierdo;
+            }
+            else {
+                nodo_actual = nodo_actual->derecho;
+            }
+        }
+    }
+
+    CursorPagina siguiente = cursor;
+    int visitados = 0;
+    while (visitados < n && (nodo_actual != nullptr || !pila_nodos.empty())) {
+        while (nodo_actual != nullptr) { pila_nodos.push(nodo_actual); nodo_actual = nodo_actual->izquierdo; }
+        nodo_actual = pila_nodos.top(); pila_nodos.pop();
+        ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
+        visitar(nodo_actual->dato);
+        siguiente.al_inicio = false;
+        siguiente.clave_promedio_cent = nodo_actual->clave_promedio_cent;
+        siguiente.id = nodo_actual->clave_id;
+        ++visitados;
+        nodo_actual = nodo_actual->derecho;
+    }
+    return siguiente;
+}
+
 // ---------- Por niveles (BFS) ----------
 
 /**
- * @brief Recorre el rbol por niveles (BFS).
- * @param visitar Funcin callback que recibe el estudiante y su nivel.
+ * @brief Recorre el árbol por niveles (BFS).
+ * @param visitar Función callback que recibe el estudiante y su nivel.
  * @details
- * Emplea una cola de pares (nodo, nivel). El nivel de la raz comienza
+ * Emplea una cola de pares (nodo, nivel). El nivel de la raíz comienza
  * en 0, y cada vez que se desciende a un hijo se incrementa en 1.
  */
 void ArbolBinarioBusqueda::por_niveles(const function<void(const Estudiante&, int)>& visitar) const {
+    ABB_REGISTRAR(++estadisticas_.recorrido.llamadas);
     if (raiz_ == nullptr) return;
     queue<pair<Nodo*, int>> cola_niveles;
     cola_niveles.push({ raiz_, 0 });
@@ -330,6 +1941,7 @@ void ArbolBinarioBusqueda::por_niveles(const function<void(const Estudiante&, in
         Nodo* nodo_actual = cola_niveles.front().first;
         int nivel_actual = cola_niveles.front().second;
         cola_niveles.pop();
+        ABB_REGISTRAR(++estadisticas_.recorrido.visitas);
 
         visitar(nodo_actual->dato, nivel_actual);
 
@@ -338,34 +1950,34 @@ void ArbolBinarioBusqueda::por_niveles(const function<void(const Estudiante&, in
     }
 }
 
-// ---------- Mtricas ----------
+// ---------- Métricas ----------
 
 /**
- * @brief Calcula la altura de un subrbol de forma recursiva.
- * @param nodo Nodo raz del subrbol.
- * @return Altura del subrbol.
+ * @brief Calcula la altura de un subárbol de forma recursiva.
+ * @param nodo Nodo raíz del subárbol.
+ * @return Altura del subárbol.
  * @details
- * Se define que un rbol vaco tiene altura -1 y un rbol con un solo
- * nodo (hoja) tiene altura 0. La altura es 1 + el mximo entre las
- * alturas de los subrboles izquierdo y derecho.
+ * Se define que un árbol vacío tiene altura -1 y un árbol con un solo
+ * nodo (hoja) tiene altura 0. La altura es 1 + el máximo entre las
+ * alturas de los subárboles izquierdo y derecho.
  */
 int ArbolBinarioBusqueda::altura_recursiva(Nodo* nodo) {
-    if (nodo == nullptr) return -1; // rbol vaco = -1; un nodo = 0
+    if (nodo == nullptr) return -1; // árbol vacío = -1; un nodo = 0
     int altura_izquierda = altura_recursiva(nodo->izquierdo);
     int altura_derecha = altura_recursiva(nodo->derecho);
     return 1 + std::max(altura_izquierda, altura_derecha);
 }
 
 /**
- * @brief Obtiene la altura del rbol completo.
- * @return Altura del rbol, o -1 si est vaco.
+ * @brief Obtiene la altura del árbol completo.
+ * @return Altura del árbol, o -1 si está vacío.
  */
 int ArbolBinarioBusqueda::altura() const { return altura_recursiva(raiz_); }
 
 /**
- * @brief Cuenta el nmero de nodos en un subrbol de forma recursiva.
- * @param nodo Nodo raz del subrbol.
- * @return Cantidad total de nodos en ese subrbol.
+ * @brief Cuenta el número de nodos en un subárbol de forma recursiva.
+ * @param nodo Nodo raíz del subárbol.
+ * @return Cantidad total de nodos en ese subárbol.
  */
 int ArbolBinarioBusqueda::contar_nodos_recursivo(Nodo* nodo) {
     if (nodo == nullptr) return 0;
@@ -373,15 +1985,18 @@ int ArbolBinarioBusqueda::contar_nodos_recursivo(Nodo* nodo) {
 }
 
 /**
- * @brief Cuenta el nmero total de nodos del rbol.
- * @return Cantidad de nodos almacenados en el rbol.
+ * @brief Cuenta el número total de nodos del árbol.
+ * @return Cantidad de nodos almacenados en el árbol.
+ * @details
+ * Se lee en O(1) del agregado de la raíz; contar_nodos_recursivo queda
+ * como referencia del cálculo completo.
  */
-int ArbolBinarioBusqueda::contar_nodos() const { return contar_nodos_recursivo(raiz_); }
+int ArbolBinarioBusqueda::contar_nodos() const { return raiz_ ? raiz_->cantidad_subarbol : 0; }
 
 /**
- * @brief Cuenta el nmero de hojas de un subrbol.
- * @param nodo Nodo raz del subrbol.
- * @return Cantidad de nodos hoja (sin hijos) en ese subrbol.
+ * @brief Cuenta el número de hojas de un subárbol.
+ * @param nodo Nodo raíz del subárbol.
+ * @return Cantidad de nodos hoja (sin hijos) en ese subárbol.
  */
 int ArbolBinarioBusqueda::contar_hojas_recursivo(Nodo* nodo) {
     if (nodo == nullptr) return 0;
@@ -390,27 +2005,27 @@ int ArbolBinarioBusqueda::contar_hojas_recursivo(Nodo* nodo) {
 }
 
 /**
- * @brief Cuenta el nmero de hojas del rbol.
- * @return Cantidad de nodos hoja del rbol completo.
+ * @brief Cuenta el número de hojas del árbol.
+ * @return Cantidad de nodos hoja del árbol completo.
  */
 int ArbolBinarioBusqueda::contar_hojas() const { return contar_hojas_recursivo(raiz_); }
 
 /**
- * @brief Cuenta el nmero de nodos internos del rbol.
+ * @brief Cuenta el número de nodos internos del árbol.
  * @return Cantidad de nodos con al menos un hijo.
  * @details
- * Se obtiene restando el nmero de hojas al nmero total de nodos.
+ * Se obtiene restando el número de hojas al número total de nodos.
  */
 int ArbolBinarioBusqueda::contar_internos() const {
     return contar_nodos() - contar_hojas();
 }
 
 /**
- * @brief Calcula el ancho mximo del rbol.
- * @return Nmero mximo de nodos encontrados en cualquier nivel.
+ * @brief Calcula el ancho máximo del árbol.
+ * @return Número máximo de nodos encontrados en cualquier nivel.
  * @details
- * Recorre el rbol por niveles y, para cada nivel, cuenta cuntos
- * nodos hay, quedndose con el mximo observado.
+ * Recorre el árbol por niveles y, para cada nivel, cuenta cuántos
+ * nodos hay, quedándose con el máximo observado.
  */
 int ArbolBinarioBusqueda::ancho_maximo() const {
     if (raiz_ == nullptr) return 0;
@@ -431,14 +2046,80 @@ int ArbolBinarioBusqueda::ancho_maximo() const {
     return ancho_mayor;
 }
 
+// ---------- Estadísticas por rango ----------
+
+/**
+ * @brief Acumula los agregados de las claves menores (o iguales) a un límite.
+ * @param nodo Raíz del subárbol.
+ * @param clave_limite Límite en centésimas.
+ * @param incluir_limite true para incluir claves iguales al límite.
+ * @param cantidad Acumulador de cantidad.
+ * @param suma Acumulador de suma.
+ * @param suma_cuadrados Acumulador de suma de cuadrados.
+ */
+void ArbolBinarioBusqueda::acumular_prefijo(Nodo* nodo, int clave_limite, bool incluir_limite,
+    long long& cantidad, long long& suma, long long& suma_cuadrados) {
+    while (nodo != nullptr) {
+        const bool dentro = incluir_limite ? nodo->clave_promedio_cent <= clave_limite
+                                           : nodo->clave_promedio_cent < clave_limite;
+        if (dentro) {
+            const long long clave = nodo->clave_promedio_cent;
+            cantidad += 1;
+            suma += clave;
+            suma_cuadrados += clave * clave;
+            if (nodo->izquierdo) {
+                cantidad += nodo->izquierdo->cantidad_subarbol;
+                suma += nodo->izquierdo->suma_subarbol;
+                suma_cuadrados += nodo->izquierdo->suma_cuadrados_subarbol;
+            }
+            nodo = nodo->derecho;
+        }
+        else {
+            nodo = nodo->izquierdo;
+        }
+    }
+}
+
+/**
+ * @brief Estadísticas de los promedios dentro de [minimo, maximo].
+ * @param minimo Límite inferior (incluido).
+ * @param maximo Límite superior (incluido).
+ * @return Cantidad, media y varianza poblacional del rango.
+ * @details
+ * Convierte los límites a centésimas igual que la inserción, resta el prefijo
+ * "clave < minimo" al prefijo "clave <= maximo" y deriva media y varianza de
+ * la suma y la suma de cuadrados.
+ */
+EstadisticasRango ArbolBinarioBusqueda::estadisticas_rango(double minimo, double maximo) const {
+    EstadisticasRango resultado;
+    const int clave_minima = convertir_promedio_a_clave(minimo);
+    const int clave_maxima = convertir_promedio_a_clave(maximo);
+    if (clave_minima > clave_maxima) return resultado;
+
+    long long cantidad_hasta = 0, suma_hasta = 0, cuadrados_hasta = 0;
+    long long cantidad_antes = 0, suma_antes = 0, cuadrados_antes = 0;
+    acumular_prefijo(raiz_, clave_maxima, true, cantidad_hasta, suma_hasta, cuadrados_hasta);
+    acumular_prefijo(raiz_, clave_minima, false, cantidad_antes, suma_antes, cuadrados_antes);
+
+    const long long cantidad = cantidad_hasta - cantidad_antes;
+    if (cantidad <= 0) return resultado;
+    const double media_cent = static_cast<double>(suma_hasta - suma_antes) / cantidad;
+    const double varianza_cent = static_cast<double>(cuadrados_hasta - cuadrados_antes) / cantidad - media_cent * media_cent;
+
+    resultado.cantidad = static_cast<int>(cantidad);
+    resultado.media = media_cent / 100.0;
+    resultado.varianza = std::max(0.0, varianza_cent) / 10000.0;
+    return resultado;
+}
+
 // ---------- Reflejo ----------
 
 /**
- * @brief Genera el reflejo de un subrbol de forma recursiva.
- * @param nodo Nodo raz del subrbol a reflejar.
+ * @brief Genera el reflejo de un subárbol de forma recursiva.
+ * @param nodo Nodo raíz del subárbol a reflejar.
  * @details
  * Intercambia los punteros a los hijos izquierdo y derecho de cada nodo,
- * aplicando el mismo proceso recursivamente a ambos subrboles.
+ * aplicando el mismo proceso recursivamente a ambos subárboles.
  */
 void ArbolBinarioBusqueda::reflejar_recursivo(Nodo* nodo) {
     if (nodo == nullptr) return;
@@ -448,14 +2129,35 @@ void ArbolBinarioBusqueda::reflejar_recursivo(Nodo* nodo) {
 }
 
 /**
- * @brief Genera el reflejo del rbol completo.
+ * @brief Genera el reflejo del árbol completo.
  * @details
- * Llama a la funcin recursiva de reflejo comenzando desde la raz.
+ * Llama a la función recursiva de reflejo comenzando desde la raíz.
  */
-void ArbolBinarioBusqueda::reflejar() { reflejar_recursivo(raiz_); }
+void ArbolBinarioBusqueda::reflejar() {
+    descongelar();
+    reflejar_recursivo(raiz_);
+}
 
 /**
- * @brief Indica si el rbol est vaco.
- * @return true si la raz es nullptr, false en caso contrario.
+ * @brief Indica si el árbol está vacío.
+ * @return true si la raíz es nullptr, false en caso contrario.
  */
 bool ArbolBinarioBusqueda::vacio() const { return raiz_ == nullptr; }
+
+
+// ---------- Instrumentación ----------
+
+/**
+ * @brief Obtiene las estadísticas de operaciones acumuladas.
+ * @return Referencia constante a los contadores e histograma.
+ */
+const EstadisticasArbol& ArbolBinarioBusqueda::estadisticas() const { return estadisticas_; }
+
+/**
+ * @brief Reinicia los contadores y el histograma conservando el indicador de habilitación.
+ */
+void ArbolBinarioBusqueda::reiniciar_estadisticas() {
+    const bool habilitadas = estadisticas_.habilitadas;
+    estadisticas_ = EstadisticasArbol();
+    estadisticas_.habilitadas = habilitadas;
+}
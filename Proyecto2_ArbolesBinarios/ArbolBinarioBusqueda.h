@@ -1,37 +1,97 @@
 #pragma once
 #include "Estudiante.h"
+#include "EstadisticasArbol.h"
+#include "FiltroBloom.h"
+#include "IndiceNombres.h"
+#include <cstdint>
+#include <exception>
 #include <functional>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 /**
- * @brief rbol binario de bsqueda para almacenar estudiantes ordenados por promedio.
+ * @brief Resultado de una consulta de estadísticas sobre un rango de promedios.
+ */
+struct EstadisticasRango {
+    int cantidad = 0;       ///< estudiantes dentro del rango
+    double media = 0.0;     ///< media de sus promedios (0.0 - 100.0)
+    double varianza = 0.0;  ///< varianza poblacional de sus promedios
+};
+
+/**
+ * @brief Posición de lectura para paginar el árbol en orden de promedio.
+ * @details
+ * Guarda la clave (promedio en centésimas, id) del último estudiante
+ * entregado; la página siguiente empieza en la primera clave estrictamente
+ * mayor. Como no apunta a nodos, sigue siendo válido aunque el árbol cambie
+ * entre páginas: lo insertado después de la clave aparece, lo anterior no.
+ *
+ * Para el cliente (por ejemplo, un front end web) el cursor es un texto
+ * opaco: codificar() y decodificar() lo convierten en 16 dígitos
+ * hexadecimales; la cadena vacía representa el inicio.
+ */
+struct CursorPagina {
+    bool al_inicio = true;        ///< true si aún no se entregó ninguna página
+    int clave_promedio_cent = 0;  ///< clave de promedio del último estudiante entregado
+    int id = 0;                   ///< id del último estudiante entregado
+
+    /**
+     * @brief Convierte el cursor en texto opaco.
+     * @return Cadena vacía para el inicio o 16 dígitos hexadecimales.
+     */
+    std::string codificar() const;
+
+    /**
+     * @brief Reconstruye un cursor a partir de codificar().
+     * @param texto Cadena recibida del cliente.
+     * @return Cursor equivalente.
+     * @throws std::invalid_argument si el texto no es un cursor válido.
+     */
+    static CursorPagina decodificar(std::string_view texto);
+};
+
+/**
+ * @brief Árbol binario de búsqueda para almacenar estudiantes ordenados por promedio.
  * @details
- * Los nodos del rbol se ordenan principalmente por el promedio del estudiante
- * (expresado en centsimas) y, en caso de empate, por el ID del estudiante.
- * Permite insertar, buscar por promedio o por ID, obtener mtricas del rbol,
- * realizar recorridos recursivos e iterativos, y generar el reflejo del rbol.
+ * Los nodos del árbol se ordenan principalmente por el promedio del estudiante
+ * (expresado en centésimas) y, en caso de empate, por el ID del estudiante.
+ * Permite insertar, buscar por promedio o por ID, obtener métricas del árbol,
+ * realizar recorridos recursivos e iterativos, y generar el reflejo del árbol.
+ *
+ * Si se compila con la macro ABB_MERKLE, cada nodo mantiene además un hash
+ * de su subárbol (hash_raiz(), diferencias()) para comparar réplicas. Sin la
+ * macro los nodos no cargan esos 16 bytes ni el costo de mantenerlos.
  */
 class ArbolBinarioBusqueda {
 private:
     /**
-     * @brief Nodo interno del rbol binario de bsqueda.
+     * @brief Nodo interno del árbol binario de búsqueda.
      * @details
      * Cada nodo almacena:
-     * - clave_promedio_cent: promedio en centsimas, usado como clave principal.
+     * - clave_promedio_cent: promedio en centésimas, usado como clave principal.
      * - clave_id: ID del estudiante, usado como criterio de desempate.
      * - dato: el objeto Estudiante asociado.
      * - punteros al hijo izquierdo y derecho.
+     * - agregados del subárbol (cantidad, suma y suma de cuadrados de las
+     *   claves de promedio), mantenidos en cada inserción.
+     * - si el nodo vive dentro de un bloque contiguo creado por compactar().
      */
     struct Nodo {
         /**
-         * @brief Promedio acadmico del estudiante en centsimas.
+         * @brief Promedio académico del estudiante en centésimas.
          * @details
-         * Se utiliza como clave principal de ordenamiento en el rbol.
+         * Se utiliza como clave principal de ordenamiento en el árbol.
          * Por ejemplo, un promedio 87.35 se almacena como 8735.
          */
-        int clave_promedio_cent; // promedio en centsimas
+        int clave_promedio_cent; // promedio en centésimas
 
         /**
-         * @brief Identificador nico del estudiante.
+         * @brief Identificador único del estudiante.
          * @details
          * Se usa como clave secundaria (desempate) cuando los promedios son iguales.
          */
@@ -53,177 +113,708 @@ private:
         Nodo* derecho;
 
         /**
-         * @brief Constructor explcito del nodo a partir de un estudiante.
-         * @param estudiante Referencia constante al estudiante que se va a almacenar.
+         * @brief Cantidad de nodos del subárbol cuya raíz es este nodo.
+         */
+        int cantidad_subarbol;
+
+        /**
+         * @brief Indica si el nodo fue construido dentro de un bloque de compactar().
+         * @details
+         * Esos nodos no se liberan con delete: solo se destruyen y la memoria
+         * se devuelve cuando se libera el bloque completo. Ocupa el relleno
+         * que ya existía tras cantidad_subarbol, así que no agranda el nodo.
+         */
+        bool en_bloque;
+
+        /**
+         * @brief Suma de clave_promedio_cent en todo el subárbol.
+         */
+        long long suma_subarbol;
+
+        /**
+         * @brief Suma de los cuadrados de clave_promedio_cent en todo el subárbol.
+         */
+        long long suma_cuadrados_subarbol;
+
+#ifdef ABB_MERKLE
+        /**
+         * @brief Hash del contenido de este nodo (ver hash_estudiante()).
+         */
+        std::uint64_t hash_dato;
+
+        /**
+         * @brief Suma (módulo 2^64) de hash_dato en todo el subárbol.
+         * @details
+         * Al ser una suma, depende solo del conjunto de estudiantes y no de la
+         * forma del subárbol: sobrevive a rotaciones, splay y rebalanceo.
+         */
+        std::uint64_t hash_subarbol;
+#endif
+
+        /**
+         * @brief Constructor explícito del nodo a partir de un estudiante.
+         * @param estudiante Estudiante que se mueve al nodo (sin copiar sus cadenas).
          * @details
          * A partir del estudiante se calculan las claves interna de promedio
-         * y de ID, y se inicializan los punteros de hijos en nullptr.
+         * y de ID, se inicializan los punteros de hijos en nullptr y los
+         * agregados con los valores de un subárbol de un solo nodo.
          */
-        explicit Nodo(const Estudiante& estudiante);
+        explicit Nodo(Estudiante&& estudiante);
     };
 
     /**
-     * @brief Puntero a la raz del rbol binario de bsqueda.
+     * @brief Puntero a la raíz del árbol binario de búsqueda.
      * @details
-     * Si el rbol est vaco, este puntero es nullptr.
+     * Si el árbol está vacío, este puntero es nullptr.
      */
     Nodo* raiz_;
 
+    /**
+     * @brief Contadores de operaciones e histograma de profundidad.
+     * @details
+     * Es mutable porque los recorridos y métricas son const pero también
+     * se contabilizan. Solo se actualiza si se compila con ABB_ESTADISTICAS.
+     */
+    mutable EstadisticasArbol estadisticas_;
+
+    /**
+     * @brief Indica si el árbol se autoajusta (splay) en cada acceso.
+     */
+    bool modo_splay_;
+
+    /**
+     * @brief Nodos enlazados a los árboles laterales durante un splay.
+     * @details
+     * Sus agregados se recalculan al final, del último al primero. Se guarda
+     * como miembro para reutilizar la capacidad entre búsquedas.
+     */
+    std::vector<Nodo*> espina_splay_;
+
+    /**
+     * @brief Bloques contiguos de nodos creados por compactar().
+     * @details
+     * Son compartidos: dividir() entrega una referencia a cada árbol destino
+     * y unir() traspasa las del otro árbol, porque sus nodos pueden terminar
+     * repartidos entre varios árboles. La memoria de un bloque se libera
+     * cuando el último árbol que lo referencia se destruye o se vuelve a compactar.
+     */
+    std::vector<std::shared_ptr<void>> bloques_;
+
+    /**
+     * @brief Función que se notifica tras cada inserción o actualización.
+     * @details
+     * Vacía por defecto; la usa, por ejemplo, EmisorReplicacion.
+     */
+    std::function<void(const Estudiante&)> observador_cambios_;
+
+    /**
+     * @brief Primera excepción que lanzó el observador de cambios, o nula.
+     * @details
+     * insertar() ya modificó el árbol cuando notifica, así que no propaga el
+     * error: lo guarda aquí para que quien inserta lo consulte.
+     */
+    std::exception_ptr error_observador_;
+
+    /**
+     * @brief Índice aprendido sobre el inorden del árbol congelado.
+     * @details
+     * Guarda las claves en arreglos ordenados y un modelo lineal por tramos
+     * de su distribución acumulada: cada segmento predice la posición de una
+     * clave con error de a lo sumo ERROR_INDICE_APRENDIDO posiciones.
+     */
+    struct IndiceAprendido {
+        /**
+         * @brief Tramo del modelo: posición ~ posicion_inicio + pendiente * (clave - clave_inicio).
+         */
+        struct Segmento {
+            int clave_inicio;
+            int posicion_inicio;
+            double pendiente;
+        };
+
+        /**
+         * @brief Una posición del inorden; la clave y el dato comparten línea de caché.
+         */
+        struct Entrada {
+            int clave_promedio_cent;
+            int id;
+            const Estudiante* estudiante;
+        };
+
+        bool valido = false;                ///< false hasta congelar() y tras cualquier cambio
+        std::vector<Entrada> entradas;      ///< inorden del árbol
+        std::vector<Segmento> segmentos;    ///< ordenados por clave_inicio
+    };
+
+    /**
+     * @brief Error máximo, en posiciones, de la predicción del índice aprendido.
+     */
+    static constexpr int ERROR_INDICE_APRENDIDO = 8;
+
+    /**
+     * @brief Índice aprendido; solo se consulta mientras es válido.
+     */
+    IndiceAprendido indice_aprendido_;
+
+    /**
+     * @brief Índice por prefijo de nombre, o nullptr si no está construido.
+     * @details
+     * Se construye en la primera llamada a buscar_por_prefijo() y desde ahí
+     * insertar() lo mantiene. Guarda punteros a los Estudiante de los nodos,
+     * así que se descarta cuando estos cambian de dirección (compactar,
+     * dividir, unir) y la siguiente búsqueda lo reconstruye.
+     */
+    std::unique_ptr<IndiceNombres> indice_nombres_;
+
+    /**
+     * @brief Clave del índice por carrera: (código de carrera, promedio en centésimas, ID).
+     */
+    struct ClaveCarrera {
+        std::uint16_t codigo_carrera;
+        int clave_promedio_cent;
+        int id;
+
+        auto operator<=>(const ClaveCarrera&) const = default;
+    };
+
+    /**
+     * @brief Índice ordenado por carrera, o nullptr si no está construido.
+     * @details
+     * Sigue el mismo ciclo que indice_nombres_: se construye en la primera
+     * consulta por carrera, insertar() lo mantiene y invalidar_indices() lo
+     * descarta. Dentro de una carrera el orden es el del árbol.
+     */
+    std::unique_ptr<std::map<ClaveCarrera, const Estudiante*>> indice_carreras_;
+
+    /**
+     * @brief Filtro de Bloom con los IDs del árbol, o nullptr si está desactivado.
+     * @details
+     * A diferencia de los índices anteriores depende solo de qué IDs hay,
+     * no de dónde viven: compactar o rebalancear no lo tocan. insertar()
+     * agrega el ID nuevo y las operaciones que quitan estudiantes (dividir,
+     * unir sobre el árbol de origen) lo reconstruyen.
+     */
+    std::unique_ptr<FiltroBloom> filtro_ids_;
+
+    /**
+     * @brief IDs esperados con que se activó el filtro.
+     */
+    std::size_t filtro_cantidad_esperada_ = 0;
+
+    /**
+     * @brief Tasa de falsos positivos con que se activó el filtro.
+     */
+    double filtro_tasa_falsos_positivos_ = 0.01;
+
     // Utilidades privadas
 
     /**
-     * @brief Compara dos pares (promedio, id) como claves del rbol.
-     * @param g1 Clave de promedio (centsimas) del primer elemento.
+     * @brief Compara dos pares (promedio, id) como claves del árbol.
+     * @param g1 Clave de promedio (centésimas) del primer elemento.
      * @param id1 ID del primer elemento.
-     * @param g2 Clave de promedio (centsimas) del segundo elemento.
+     * @param g2 Clave de promedio (centésimas) del segundo elemento.
      * @param id2 ID del segundo elemento.
      * @return
      * - Valor negativo si (g1, id1) < (g2, id2)
      * - 0 si son equivalentes
      * - Valor positivo si (g1, id1) > (g2, id2)
      * @details
-     * La comparacin se hace primero por promedio; si son iguales,
+     * La comparación se hace primero por promedio; si son iguales,
      * se compara por ID.
      */
     static int comparar_claves(int g1, int id1, int g2, int id2);
 
     /**
-     * @brief Libera todos los nodos del rbol en recorrido postorden.
-     * @param nodo Puntero al nodo actual desde el que se inicia la liberacin.
+     * @brief Libera todos los nodos del árbol en recorrido postorden.
+     * @param nodo Puntero al nodo actual desde el que se inicia la liberación.
      * @details
      * Se usa en el destructor para liberar memoria de forma recursiva
-     * desde la raz.
+     * desde la raíz.
      */
     static void liberar_postorden(Nodo* nodo);
 
-    // Insercin / bsqueda
+    /**
+     * @brief Libera un único nodo según su origen.
+     * @param nodo Nodo a liberar.
+     * @details
+     * Los nodos creados con new se eliminan con delete; los que viven en un
+     * bloque de compactar() solo se destruyen en su lugar.
+     */
+    static void liberar_nodo(Nodo* nodo);
+
+    /**
+     * @brief Agrega a un vector los nodos de los primeros niveles de un subárbol en orden van Emde Boas.
+     * @param nodo Raíz del subárbol.
+     * @param niveles Cantidad de niveles a colocar desde nodo.
+     * @param orden Vector de salida.
+     * @details
+     * Coloca primero el "árbol superior" (la mitad de arriba de los niveles)
+     * y después, de izquierda a derecha, cada árbol inferior que cuelga de
+     * él, aplicando la misma regla recursivamente. Cada subárbol de k
+     * niveles termina en un tramo contiguo, sea cual sea el tamaño de línea
+     * de caché o de página.
+     */
+    static void colocar_van_emde_boas(Nodo* nodo, int niveles, std::vector<Nodo*>& orden);
 
     /**
-     * @brief Inserta recursivamente un estudiante en el rbol.
-     * @param nodo Raz del subrbol donde se desea insertar.
-     * @param estudiante Estudiante a insertar.
-     * @return Puntero a la nueva raz del subrbol tras la insercin.
+     * @brief Copia un subárbol dentro de un bloque, en preorden.
+     * @param origen Raíz del subárbol a copiar (no puede ser nullptr).
+     * @param bloque Inicio del bloque destino.
+     * @param posicion Posición del bloque donde va la copia de origen.
+     * @param hilos Hilos que puede usar esta llamada (incluido el actual).
+     * @return Copia de origen dentro del bloque.
+     * @details
+     * Gracias a cantidad_subarbol, la posición de cada subárbol se conoce de
+     * antemano: el izquierdo empieza en posicion + 1 y el derecho justo
+     * después de él. Por eso los dos subárboles se pueden copiar a la vez
+     * sin coordinarse: si hay hilos libres y el subárbol izquierdo es grande,
+     * se copia en un hilo nuevo mientras el actual copia el derecho.
+     */
+    static Nodo* clonar_recursivo(const Nodo* origen, Nodo* bloque, size_t posicion, unsigned hilos);
+
+    /**
+     * @brief Recalcula los agregados de un nodo a partir de sus hijos.
+     * @param nodo Nodo cuyos agregados se actualizan (no puede ser nullptr).
+     * @details
+     * Supone que los agregados de ambos hijos ya son correctos. Debe llamarse
+     * en cada nodo cuyo subárbol cambie, de abajo hacia arriba.
+     */
+    static void recalcular_agregados(Nodo* nodo);
+
+    /**
+     * @brief Copia los agregados de subárbol de un nodo a otro.
+     * @param destino Nodo que recibe los valores.
+     * @param origen Nodo del que se leen.
+     * @details
+     * Lo usan las reubicaciones (compactar, clonar), que construyen el nodo
+     * nuevo antes de que sus hijos estén enlazados.
+     */
+    static void copiar_agregados(Nodo* destino, const Nodo* origen);
+
+#ifdef ABB_MERKLE
+    /**
+     * @brief Hash de 64 bits del contenido de un estudiante.
+     * @param estudiante Estudiante a resumir.
+     * @return Hash de ID, promedio, nombre y texto de la carrera.
+     * @details
+     * Se usa el texto de la carrera y no su código, porque los códigos del
+     * diccionario dependen del orden de inserción de cada proceso.
+     */
+    static std::uint64_t hash_estudiante(const Estudiante& estudiante);
+
+    /**
+     * @brief Compara dos subárboles que cubren el mismo rango de claves.
+     * @param propio Subárbol de este árbol.
+     * @param ajeno Subárbol del otro árbol.
+     * @param visitar Callback de diferencias (ver diferencias()).
+     */
+    static void diferencias_recursivo(const Nodo* propio, const Nodo* ajeno,
+        const std::function<void(const Estudiante*, const Estudiante*)>& visitar);
+#endif
+
+    /**
+     * @brief Acumula los agregados de todas las claves menores (o iguales) a un límite.
+     * @param nodo Raíz del subárbol.
+     * @param clave_limite Promedio en centésimas que sirve de límite.
+     * @param incluir_limite Si es true también se cuentan las claves iguales al límite.
+     * @param cantidad Acumulador de cantidad.
+     * @param suma Acumulador de suma de claves.
+     * @param suma_cuadrados Acumulador de suma de cuadrados.
+     * @details
+     * Desciende una sola rama: cuando el nodo cae dentro del prefijo se suman
+     * el nodo y todo su subárbol izquierdo de una vez y se continúa por la
+     * derecha; en otro caso se continúa por la izquierda. Cuesta O(altura).
+     */
+    static void acumular_prefijo(Nodo* nodo, int clave_limite, bool incluir_limite,
+        long long& cantidad, long long& suma, long long& suma_cuadrados);
+
+    // Rotaciones / splay
+
+    /**
+     * @brief Rota a la derecha: el hijo izquierdo sube a la posición del nodo.
+     * @param nodo Raíz del subárbol; debe tener hijo izquierdo.
+     * @return Nueva raíz del subárbol.
+     * @details
+     * Recalcula los agregados del nodo que baja y luego los del que sube.
+     */
+    static Nodo* rotar_derecha(Nodo* nodo);
+
+    /**
+     * @brief Rota a la izquierda: el hijo derecho sube a la posición del nodo.
+     * @param nodo Raíz del subárbol; debe tener hijo derecho.
+     * @return Nueva raíz del subárbol.
+     */
+    static Nodo* rotar_izquierda(Nodo* nodo);
+
+    /**
+     * @brief Lleva a la raíz el nodo con la clave indicada (splay descendente).
+     * @param raiz Raíz del árbol.
+     * @param clave_promedio_cent Promedio buscado en centésimas.
+     * @param clave_id ID de desempate (se ignora si solo_promedio es true).
+     * @param solo_promedio Si es true basta con coincidir en el promedio.
+     * @param contadores Contadores de la operación que origina el splay.
+     * @return Nueva raíz: el nodo buscado o, si no existe, el último nodo del camino.
+     * @details
+     * Variante descendente de Sleator y Tarjan: en un solo recorrido iterativo
+     * se rota en los pasos zig-zig y se van colgando los nodos del camino en
+     * dos árboles laterales, que al final pasan a ser los hijos de la nueva
+     * raíz. No usa recursión, por lo que soporta caminos muy largos.
+     */
+    Nodo* splay(Nodo* raiz, int clave_promedio_cent, int clave_id, bool solo_promedio, ContadoresOperacion& contadores);
+
+    /**
+     * @brief Aplica una serie de rotaciones a la izquierda sobre la espina derecha.
+     * @param raiz Raíz de la espina (se actualiza).
+     * @param cantidad Número de rotaciones.
+     * @details
+     * Fase de compresión del algoritmo de Day-Stout-Warren: rota cada segundo
+     * nodo de la espina, bajando a la izquierda el nodo que queda encima.
+     */
+    static void comprimir_espina(Nodo*& raiz, int cantidad);
+
+    /**
+     * @brief Descarta los índices derivados del contenido o de la ubicación de los nodos.
+     * @details
+     * Punto único que llaman las operaciones que mueven estudiantes de
+     * dirección o entre árboles (compactar, dividir, unir, movimientos):
+     * descarta el índice aprendido y los de nombres y carreras.
+     */
+    void invalidar_indices();
+
+    /**
+     * @brief Construye el índice por carrera si no existe.
+     * @details
+     * Ordena el inorden por carrera y llena el mapa en orden: O(n log n).
+     */
+    void preparar_indice_carreras();
+
+    /**
+     * @brief Vuelve a llenar el filtro de IDs con el contenido actual, si está activo.
+     * @details
+     * Lo dimensiona para el mayor entre los IDs esperados y los nodos
+     * actuales, así un árbol que creció más de lo previsto recupera la tasa
+     * de falsos positivos pedida. Cuesta O(n).
+     */
+    void reconstruir_filtro_ids();
+
+    /**
+     * @brief Agrega al filtro de IDs todos los IDs de un subárbol.
+     * @param nodo Raíz del subárbol (puede ser nullptr).
+     */
+    void agregar_ids_al_filtro(const Nodo* nodo);
+
+    /**
+     * @brief Descarta solo el índice aprendido.
+     * @details
+     * Para los cambios que alteran el orden o el contenido pero dejan a
+     * cada Estudiante en su nodo (insertar, rebalancear, reflejar); el
+     * los índices de nombres y carreras siguen siendo válidos o insertar()
+     * los actualiza.
+     */
+    void descongelar();
+
+    /**
+     * @brief Cota inferior de una clave en el índice aprendido.
+     * @param clave_promedio_cent Clave de promedio.
+     * @param clave_id ID de desempate.
+     * @param estricta true para la primera clave estrictamente mayor.
+     * @param contadores Si no es nulo, suma una visita y una comparación por
+     *        entrada examinada (solo con ABB_ESTADISTICAS).
+     * @return Posición en los arreglos del índice (puede ser su tamaño).
+     * @details
+     * Parte de la posición predicha por el segmento correspondiente y busca
+     * en una ventana de ERROR_INDICE_APRENDIDO posiciones a cada lado; si la
+     * ventana no contiene la respuesta (claves ausentes en un tramo con
+     * muchos repetidos) la amplía duplicando el paso.
+     */
+    std::size_t posicion_aprendida(int clave_promedio_cent, int clave_id, bool estricta, ContadoresOperacion* contadores = nullptr) const;
+
+    // Inserción / búsqueda
+
+    /**
+     * @brief Inserta recursivamente un estudiante en el árbol.
+     * @param nodo Raíz del subárbol donde se desea insertar.
+     * @param estudiante Estudiante a insertar; se mueve al nodo nuevo o al existente.
+     * @param clave_promedio_cent Promedio del estudiante ya convertido a centésimas,
+     *                            calculado una sola vez por quien llama.
+     * @return Puntero a la nueva raíz del subárbol tras la inserción.
      * @details
      * Si el nodo es nullptr, se crea uno nuevo. En caso contrario,
-     * se decide avanzar a la izquierda o derecha segn las claves
-     * (promedio en centsimas y ID).
+     * se decide avanzar a la izquierda o derecha según las claves
+     * (promedio en centésimas y ID). Si los índices de nombres o carreras
+     * existen, agrega el nodo nuevo o reindexa el actualizado cuando cambió
+     * su nombre o su carrera.
      */
-    static Nodo* insertar_recursivo(Nodo* nodo, const Estudiante& estudiante);
+    Nodo* insertar_recursivo(Nodo* nodo, Estudiante&& estudiante, int clave_promedio_cent);
 
     /**
-     * @brief Busca recursivamente un estudiante por su promedio (en centsimas).
-     * @param nodo Raz del subrbol donde se realiza la bsqueda.
-     * @param clave_promedio_cent Promedio en centsimas a buscar.
-     * @return Puntero al nodo encontrado o nullptr si no existe coincidencia.
-     * @note La bsqueda es por coincidencia exacta de la clave de promedio.
+     * @brief Busca el estudiante de menor ID con un promedio (en centésimas).
+     * @param nodo Raíz del subárbol donde se realiza la búsqueda.
+     * @param clave_promedio_cent Promedio en centésimas a buscar.
+     * @return El nodo de menor ID con ese promedio, o nullptr si no hay.
+     * @note La búsqueda es por coincidencia exacta de la clave de promedio.
      */
-    static Nodo* buscar_por_promedio_recursivo(Nodo* nodo, int clave_promedio_cent);
+    Nodo* buscar_primero_por_promedio(Nodo* nodo, int clave_promedio_cent);
 
     /**
      * @brief Busca recursivamente un estudiante por su ID.
-     * @param nodo Raz del subrbol donde se realiza la bsqueda.
+     * @param nodo Raíz del subárbol donde se realiza la búsqueda.
      * @param id ID del estudiante a buscar.
      * @return Puntero al nodo encontrado o nullptr si no se encuentra.
-     * @warning El rbol no est ordenado por ID, por lo que esta bsqueda
-     *          puede requerir recorrer todo el rbol.
+     * @warning El árbol no está ordenado por ID, por lo que esta búsqueda
+     *          puede requerir recorrer todo el árbol.
+     */
+    Nodo* buscar_por_id_recursivo(Nodo* nodo, int id);
+
+    /**
+     * @brief Resuelve recursivamente un lote de búsquedas por promedio en un solo descenso.
+     * @param nodo Raíz del subárbol actual.
+     * @param inicio Primera sonda (clave en centésimas, posición original) del rango a resolver.
+     * @param fin Posición siguiente a la última sonda del rango.
+     * @param resultados Vector de salida indexado por la posición original de cada sonda.
+     * @details
+     * Las sondas vienen ordenadas por clave. En cada nodo se parten en tres grupos
+     * (menores, iguales, mayores): las iguales se resuelven en el nodo y siguen
+     * por la izquierda junto con las menores, por si hay un ID menor con el mismo
+     * promedio; las mayores descienden por la derecha, como en una mezcla.
+     */
+    void buscar_lote_recursivo(Nodo* nodo, const std::pair<int, size_t>* inicio, const std::pair<int, size_t>* fin,
+        std::vector<const Estudiante*>& resultados);
+
+    // División / unión
+
+    /**
+     * @brief Separa un subárbol en claves menores y mayores o iguales a un promedio.
+     * @param nodo Raíz del subárbol a separar.
+     * @param clave_promedio_cent Promedio de corte en centésimas.
+     * @return Par (raíz de menores, raíz de mayores o iguales).
+     * @details
+     * Solo recorre el camino de búsqueda de la clave de corte: cada nodo del
+     * camino se cuelga entero de uno de los dos lados y se recalculan sus
+     * agregados. Cuesta O(altura) y no copia ningún Estudiante.
+     */
+    static std::pair<Nodo*, Nodo*> dividir_recursivo(Nodo* nodo, int clave_promedio_cent);
+
+    /**
+     * @brief Desconecta el nodo con la mayor clave de un subárbol.
+     * @param nodo Raíz del subárbol (no puede ser nullptr).
+     * @param maximo Recibe el nodo desconectado.
+     * @return Nueva raíz del subárbol sin ese nodo.
+     */
+    static Nodo* extraer_maximo(Nodo* nodo, Nodo*& maximo);
+
+    /**
+     * @brief Desconecta el nodo con la menor clave de un subárbol.
+     * @param nodo Raíz del subárbol (no puede ser nullptr).
+     * @param minimo Recibe el nodo desconectado.
+     * @return Nueva raíz del subárbol sin ese nodo.
+     */
+    static Nodo* extraer_minimo(Nodo* nodo, Nodo*& minimo);
+
+    /**
+     * @brief Enlaza un nodo ya existente (sin hijos) en el subárbol.
+     * @param nodo Raíz del subárbol.
+     * @param nuevo Nodo a enlazar; sus hijos deben ser nullptr.
+     * @return Nueva raíz del subárbol.
+     * @details
+     * Es la inserción normal pero reutilizando el nodo en lugar de crearlo.
+     * Si ya existe un nodo con la misma clave, se le mueve el dato de nuevo
+     * y se libera el nodo sobrante.
+     */
+    static Nodo* enlazar_nodo(Nodo* nodo, Nodo* nuevo);
+
+    // Operaciones de conjuntos
+
+    /**
+     * @brief Agrega a un vector los nodos de un subárbol en inorden.
+     * @param nodo Raíz del subárbol.
+     * @param salida Vector donde se agregan los nodos, de menor a mayor clave.
+     */
+    static void recolectar_inorden(const Nodo* nodo, std::vector<const Nodo*>& salida);
+
+    /**
+     * @brief Construye un subárbol balanceado con copias de nodos ya ordenados.
+     * @param inicio Primer nodo fuente (ordenados por clave).
+     * @param cantidad Cantidad de nodos fuente.
+     * @param bloque Bloque destino.
+     * @param posicion Posición del bloque para la raíz del subárbol.
+     * @return Raíz del subárbol construido, o nullptr si cantidad es 0.
+     * @details
+     * La mediana es la raíz y cada mitad se construye igual; las copias
+     * quedan en preorden dentro del bloque. La altura resultante es mínima.
+     */
+    static Nodo* construir_balanceado(const Nodo* const* inicio, size_t cantidad, Nodo* bloque, size_t posicion);
+
+    /**
+     * @brief Mezcla los inorden de dos árboles y construye el resultado.
+     * @param a Primer árbol.
+     * @param b Segundo árbol.
+     * @param solo_a Conservar los estudiantes cuyo ID solo está en a.
+     * @param en_ambos Conservar los IDs presentes en los dos (se copia el de a).
+     * @param solo_b Conservar los estudiantes cuyo ID solo está en b.
+     * @return Árbol balanceado con los estudiantes seleccionados.
      */
-    static Nodo* buscar_por_id_recursivo(Nodo* nodo, int id);
+    static ArbolBinarioBusqueda combinar(const ArbolBinarioBusqueda& a, const ArbolBinarioBusqueda& b,
+        bool solo_a, bool en_ambos, bool solo_b);
 
     // Recorridos (privados recursivos)
 
     /**
-     * @brief Recorre el rbol en preorden de manera recursiva.
+     * @brief Recorre el árbol en preorden de manera recursiva.
      * @param nodo Nodo actual en el recorrido.
-     * @param visitar Funcin callback que recibe un Estudiante constante
+     * @param visitar Función callback que recibe un Estudiante constante
      *                y se invoca en el orden del recorrido.
      */
-    static void preorden_recursivo(Nodo* nodo, const std::function<void(const Estudiante&)>& visitar);
+    void preorden_recursivo(Nodo* nodo, const std::function<void(const Estudiante&)>& visitar) const;
 
     /**
-     * @brief Recorre el rbol en inorden de manera recursiva.
+     * @brief Recorre el árbol en inorden de manera recursiva.
      * @param nodo Nodo actual en el recorrido.
-     * @param visitar Funcin callback para procesar cada estudiante.
+     * @param visitar Función callback para procesar cada estudiante.
      * @details
-     * El recorrido inorden visita primero el subrbol izquierdo,
-     * luego el nodo actual y finalmente el subrbol derecho, dejando
-     * los estudiantes en orden ascendente segn su clave.
+     * El recorrido inorden visita primero el subárbol izquierdo,
+     * luego el nodo actual y finalmente el subárbol derecho, dejando
+     * los estudiantes en orden ascendente según su clave.
      */
-    static void inorden_recursivo(Nodo* nodo, const std::function<void(const Estudiante&)>& visitar);
+    void inorden_recursivo(Nodo* nodo, const std::function<void(const Estudiante&)>& visitar) const;
 
     /**
-     * @brief Recorre el rbol en postorden de manera recursiva.
+     * @brief Recorre el árbol en postorden de manera recursiva.
      * @param nodo Nodo actual en el recorrido.
-     * @param visitar Funcin callback para procesar cada estudiante.
+     * @param visitar Función callback para procesar cada estudiante.
      */
-    static void postorden_recursivo(Nodo* nodo, const std::function<void(const Estudiante&)>& visitar);
+    void postorden_recursivo(Nodo* nodo, const std::function<void(const Estudiante&)>& visitar) const;
 
-    // Mtricas
+    // Métricas
 
     /**
-     * @brief Calcula la altura del rbol de forma recursiva.
-     * @param nodo Nodo actual del subrbol.
-     * @return Altura del subrbol cuya raz es nodo.
+     * @brief Calcula la altura del árbol de forma recursiva.
+     * @param nodo Nodo actual del subárbol.
+     * @return Altura del subárbol cuya raíz es nodo.
      * @details
-     * Un rbol vaco tiene altura 0. Un rbol con solo la raz tiene altura 1.
+     * Un árbol vacío tiene altura 0. Un árbol con solo la raíz tiene altura 1.
      */
     static int altura_recursiva(Nodo* nodo);
 
     /**
-     * @brief Cuenta el nmero de nodos en el subrbol de forma recursiva.
-     * @param nodo Nodo raz del subrbol.
-     * @return Cantidad total de nodos del subrbol.
+     * @brief Cuenta el número de nodos en el subárbol de forma recursiva.
+     * @param nodo Nodo raíz del subárbol.
+     * @return Cantidad total de nodos del subárbol.
      */
     static int contar_nodos_recursivo(Nodo* nodo);
 
     /**
-     * @brief Cuenta el nmero de hojas en el subrbol de forma recursiva.
-     * @param nodo Nodo raz del subrbol.
-     * @return Cantidad de nodos hoja (sin hijos) del subrbol.
+     * @brief Cuenta el número de hojas en el subárbol de forma recursiva.
+     * @param nodo Nodo raíz del subárbol.
+     * @return Cantidad de nodos hoja (sin hijos) del subárbol.
      */
     static int contar_hojas_recursivo(Nodo* nodo);
 
     // Reflejo
 
     /**
-     * @brief Genera el reflejo del subrbol intercambiando hijos izquierdo y derecho.
-     * @param nodo Nodo actual del subrbol a reflejar.
+     * @brief Genera el reflejo del subárbol intercambiando hijos izquierdo y derecho.
+     * @param nodo Nodo actual del subárbol a reflejar.
      * @details
-     * Este proceso se aplica recursivamente a todos los nodos del subrbol.
+     * Este proceso se aplica recursivamente a todos los nodos del subárbol.
      */
     static void reflejar_recursivo(Nodo* nodo);
 
 public:
     /**
-     * @brief Constructor por defecto del rbol binario de bsqueda.
+     * @brief Constructor por defecto del árbol binario de búsqueda.
      * @details
-     * Inicializa la raz en nullptr, indicando que el rbol est vaco.
+     * Inicializa la raíz en nullptr, indicando que el árbol está vacío.
      */
     ArbolBinarioBusqueda();
 
     /**
-     * @brief Destructor del rbol binario de bsqueda.
+     * @brief Destructor del árbol binario de búsqueda.
      * @details
-     * Libera recursivamente todos los nodos del rbol para evitar fugas de memoria.
+     * Libera recursivamente todos los nodos del árbol para evitar fugas de memoria.
      */
     ~ArbolBinarioBusqueda();
 
+    /**
+     * @brief La copia implícita se elimina.
+     * @details
+     * Copiar solo el puntero a la raíz haría que dos árboles liberaran los
+     * mismos nodos. Para una copia profunda se usa clonar() de forma explícita.
+     */
+    ArbolBinarioBusqueda(const ArbolBinarioBusqueda&) = delete;
+
+    /**
+     * @brief La asignación por copia se elimina (ver clonar()).
+     */
+    ArbolBinarioBusqueda& operator=(const ArbolBinarioBusqueda&) = delete;
+
+    /**
+     * @brief Constructor de movimiento; no lanza excepciones.
+     * @param otro Árbol cuyos nodos, bloques y modo se toman; queda vacío.
+     * @details
+     * Cuesta O(1): permite devolver un árbol desde una función o entregarlo
+     * a otro hilo sin copiar nodos.
+     */
+    ArbolBinarioBusqueda(ArbolBinarioBusqueda&& otro) noexcept;
+
+    /**
+     * @brief Asignación por movimiento; no lanza excepciones.
+     * @param otro Árbol de origen; queda vacío.
+     * @return Referencia a este árbol.
+     * @details
+     * Libera los nodos que tuviera este árbol y toma los de otro.
+     */
+    ArbolBinarioBusqueda& operator=(ArbolBinarioBusqueda&& otro) noexcept;
+
+    /**
+     * @brief Crea una copia profunda e independiente del árbol.
+     * @return Árbol con la misma forma, los mismos estudiantes, el mismo modo
+     *         splay y una copia del filtro de IDs.
+     * @details
+     * Todos los nodos de la copia se reservan en un único bloque contiguo
+     * (en preorden) y los subárboles grandes se copian en paralelo, usando
+     * hasta std::thread::hardware_concurrency() hilos. Cuesta O(n) de trabajo
+     * total. Las estadísticas de la copia empiezan en cero.
+     */
+    ArbolBinarioBusqueda clonar() const;
+
     // Operaciones principales
 
     /**
-     * @brief Inserta un estudiante en el rbol.
+     * @brief Inserta un estudiante en el árbol.
      * @param estudiante Estudiante a insertar.
      * @details
-     * El estudiante se ubica de acuerdo con su promedio (convertido a centsimas)
-     * y, en caso de empate, segn su ID.
+     * El estudiante se ubica de acuerdo con su promedio (convertido a centésimas)
+     * y, en caso de empate, según su ID.
      */
     void insertar(const Estudiante& estudiante);
 
+    /**
+     * @brief Inserta un estudiante moviéndolo al árbol.
+     * @param estudiante Estudiante temporal o movido con std::move.
+     * @details
+     * Sus cadenas pasan al nodo sin copiarse, tanto si se crea un nodo nuevo
+     * como si se actualiza uno con la misma clave. Es la variante adecuada
+     * para cargas masivas.
+     */
+    void insertar(Estudiante&& estudiante);
+
+    /**
+     * @brief Construye un estudiante con los datos dados y lo inserta.
+     * @param id Identificador único del estudiante.
+     * @param nombre Nombre; se mueve hasta el nodo sin copias intermedias.
+     * @param carrera Carrera o programa académico.
+     * @param promedio Promedio académico en escala 0.0 - 100.0.
+     */
+    void emplazar(int id, std::string nombre, std::string_view carrera, double promedio);
+
     /**
      * @brief Busca un estudiante por su promedio.
-     * @param promedio Promedio acadmico en escala 0.0 - 100.0.
-     * @return Puntero constante al estudiante si se encuentra, o nullptr si no existe.
-     * @note La bsqueda se realiza por coincidencia exacta de la clave en centsimas,
-     *       es decir, se convierte el promedio con la misma lgica que la insercin.
+     * @param promedio Promedio académico en escala 0.0 - 100.0.
+     * @return El estudiante de menor ID con ese promedio, o nullptr si no existe.
+     * @note La búsqueda se realiza por coincidencia exacta de la clave en centésimas,
+     *       es decir, se convierte el promedio con la misma lógica que la inserción.
+     *       El resultado es el mismo con o sin índice aprendido y en modo splay.
      */
     const Estudiante* buscar_por_promedio(double promedio); // coincidencia exacta
 
@@ -231,114 +822,500 @@ public:
      * @brief Busca un estudiante por su ID.
      * @param id Identificador del estudiante a buscar.
      * @return Puntero constante al estudiante si se encuentra, o nullptr si no existe.
-     * @warning El rbol no est ordenado por ID, por lo que esta operacin puede ser O(n).
+     * @warning El árbol no está ordenado por ID, por lo que esta operación puede ser O(n).
+     * @note Con el filtro de IDs activo (activar_filtro_ids()), un ID ausente
+     *       se descarta casi siempre sin recorrer el árbol.
+     */
+    const Estudiante* buscar_por_id(int id);                // no está ordenado por ID
+
+    /**
+     * @brief Busca varios promedios a la vez compartiendo el camino de búsqueda.
+     * @param promedios Promedios a buscar (escala 0.0 - 100.0), en cualquier orden.
+     * @return Vector del mismo tamaño que promedios; la posición i contiene el
+     *         estudiante encontrado para promedios[i] o nullptr si no existe.
+     * @details
+     * Ordena las claves y las resuelve en un único descenso coordinado: cada nodo
+     * se visita una sola vez por lote aunque lo atraviesen muchas sondas, y se
+     * precargan ambos hijos antes de descender para solapar los fallos de caché
+     * de las ramas independientes. El resultado de cada sonda coincide con el
+     * de buscar_por_promedio.
+     */
+    std::vector<const Estudiante*> buscar_lote(std::span<const double> promedios);
+
+    /**
+     * @brief Busca varios IDs a la vez con un único recorrido del árbol.
+     * @param ids IDs a buscar, en cualquier orden.
+     * @return Vector del mismo tamaño que ids con el estudiante encontrado o nullptr.
+     * @details
+     * Como el árbol no está ordenado por ID, cada buscar_por_id cuesta O(n);
+     * el lote recorre el árbol una sola vez (O(n + k)) y se detiene en cuanto
+     * todas las sondas están resueltas. Ante IDs repetidos devuelve el mismo
+     * estudiante que buscar_por_id (el primero en preorden).
+     */
+    std::vector<const Estudiante*> buscar_lote_por_id(std::span<const int> ids);
+
+    /**
+     * @brief Busca los estudiantes cuyo nombre empieza con un prefijo.
+     * @param prefijo Prefijo del nombre; no distingue mayúsculas (ASCII y Latin-1).
+     * @param limite Cantidad máxima de resultados.
+     * @return Estudiantes encontrados, en orden alfabético de nombre (por bytes).
+     * @details
+     * Consulta un árbol radix sobre los nombres: cuesta O(largo del prefijo + k)
+     * para k resultados, en vez de recorrer el árbol comparando nombre().
+     * La primera llamada (o la primera tras compactar, dividir o unir)
+     * construye el índice en O(n); después insertar() lo mantiene al día.
+     */
+    std::vector<const Estudiante*> buscar_por_prefijo(std::string_view prefijo, std::size_t limite = SIZE_MAX);
+
+    // Consultas por carrera
+
+    /**
+     * @brief Visita los estudiantes de una carrera con promedio dentro de [minimo, maximo].
+     * @param carrera Carrera (texto exacto, como se insertó).
+     * @param minimo Promedio mínimo (incluido).
+     * @param maximo Promedio máximo (incluido).
+     * @param visitar Función callback para cada estudiante, en orden ascendente.
+     * @details
+     * Usa un índice secundario ordenado por (carrera, promedio, ID): cuesta
+     * O(log n + k) para k resultados, en vez de filtrar todo el árbol. La
+     * primera consulta por carrera (o la primera tras compactar, dividir o
+     * unir) construye el índice en O(n log n); después insertar() lo
+     * mantiene al día.
+     */
+    void rango_por_carrera(std::string_view carrera, double minimo, double maximo,
+        const std::function<void(const Estudiante&)>& visitar);
+
+    /**
+     * @brief Visita los k estudiantes de una carrera con mayor promedio, de mayor a menor.
+     * @param carrera Carrera (texto exacto).
+     * @param k Cantidad máxima de estudiantes.
+     * @param visitar Función callback para cada estudiante.
+     * @details
+     * O(log n + k) con el índice por carrera; los empates se ordenan por ID
+     * descendente, como en top_k().
+     */
+    void top_k_por_carrera(std::string_view carrera, int k, const std::function<void(const Estudiante&)>& visitar);
+
+    // Filtro de IDs
+
+    /**
+     * @brief Activa un filtro de Bloom delante de buscar_por_id y buscar_lote_por_id.
+     * @param cantidad_esperada IDs que se espera guardar (dimensiona el filtro).
+     * @param tasa_falsos_positivos Fracción de IDs ausentes que igual recorren el árbol.
+     * @throws std::invalid_argument si la tasa no está en (0, 1).
+     * @details
+     * Muchas búsquedas por ID son de IDs que no existen (por ejemplo, validar
+     * un aspirante nuevo), y cada una es el peor caso: un recorrido O(n). Con
+     * el filtro activo, esas búsquedas responden nullptr tras leer una línea
+     * de caché, salvo una fracción tasa_falsos_positivos que recorre el árbol
+     * como antes. Los IDs presentes no cambian de costo.
+     *
+     * Se llena con los IDs actuales en O(n) y ocupa unos 12 bits por ID al
+     * 1 %. insertar() lo mantiene; si se supera cantidad_esperada la tasa
+     * sube hasta la siguiente reconstrucción (dividir, unir o una nueva
+     * llamada a esta función). Mientras esté activo, dividir cuesta O(n) y
+     * unir O(m) para mantenerlo al día.
+     */
+    void activar_filtro_ids(std::size_t cantidad_esperada, double tasa_falsos_positivos = 0.01);
+
+    /**
+     * @brief Desactiva el filtro de IDs y libera su memoria.
+     */
+    void desactivar_filtro_ids();
+
+    /**
+     * @brief Indica si el filtro de IDs está activo.
+     */
+    bool filtro_ids_activo() const;
+
+    // Modo splay
+
+    /**
+     * @brief Activa o desactiva el autoajuste (árbol splay).
+     * @param activo true para activar el modo splay.
+     * @details
+     * Con el modo activo, insertar, buscar_por_promedio y buscar_por_id suben
+     * el nodo accedido a la raíz. Los estudiantes consultados con frecuencia
+     * quedan cerca de la raíz y su búsqueda visita pocos nodos; el costo
+     * amortizado de cada operación es O(log n) aunque el árbol se vea
+     * degenerado en algún momento. Las búsquedas por lote no reorganizan el
+     * árbol. Se puede cambiar en cualquier momento: el árbol sigue siendo un
+     * árbol de búsqueda válido.
+     */
+    void set_modo_splay(bool activo);
+
+    /**
+     * @brief Indica si el modo splay está activo.
+     * @return true si los accesos reorganizan el árbol.
+     */
+    bool modo_splay() const;
+
+    // Notificación de cambios
+
+    /**
+     * @brief Registra una función que recibe cada estudiante insertado o actualizado.
+     * @param observador Función a llamar, o una función vacía para dejar de notificar.
+     * @details
+     * Se llama al final de insertar() (y por lo tanto de emplazar()) con el
+     * estudiante tal como quedó guardado en el árbol. Es la fuente del flujo
+     * de replicación. Las operaciones que solo mueven nodos entre árboles
+     * (dividir, unir, movimientos) o los reubican (compactar, rebalancear)
+     * no notifican.
+     *
+     * Si el observador lanza, la inserción ya ocurrió: insertar() no falla,
+     * guarda la primera excepción y la expone en error_observador(). Cambiar
+     * de observador descarta el error guardado.
+     */
+    void set_observador_cambios(std::function<void(const Estudiante&)> observador);
+
+    /**
+     * @brief Primera excepción lanzada por el observador desde que se registró.
+     * @return Excepción guardada, o un exception_ptr nulo si no hubo error.
+     * @details
+     * Con EmisorReplicacion indica que la réplica dejó de recibir cambios
+     * (flujo roto o estudiante que el formato no admite).
+     */
+    std::exception_ptr error_observador() const;
+
+    /**
+     * @brief Descarta el error guardado del observador.
+     */
+    void limpiar_error_observador();
+
+    // Índice aprendido
+
+    /**
+     * @brief Congela la lista actual y construye su índice aprendido.
+     * @details
+     * Copia el inorden a arreglos ordenados (clave, ID, estudiante) y ajusta
+     * un modelo lineal por tramos de la distribución acumulada de promedios
+     * (un cono que se angosta con cada clave y abre un tramo nuevo cuando el
+     * error supera ERROR_INDICE_APRENDIDO). Los promedios se concentran entre
+     * 60 y 95 y su distribución es suave, así que bastan pocos tramos.
+     *
+     * Mientras el árbol siga congelado, buscar_por_promedio, buscar_lote y
+     * siguiente_pagina predicen la posición y buscan localmente en el
+     * arreglo en vez de recorrer punteros; con el índice, buscar_por_promedio
+     * devuelve el estudiante de menor ID con ese promedio. Cualquier
+     * operación que modifique el árbol (insertar, emplazar, rebalancear,
+     * compactar, dividir, unir, reflejar) lo descongela; se vuelve a llamar
+     * a congelar() para reconstruirlo. Cuesta O(n) y 16 bytes por estudiante.
+     */
+    void congelar();
+
+    /**
+     * @brief Indica si el índice aprendido está vigente.
+     * @return true entre congelar() y la siguiente modificación.
+     */
+    bool congelado() const;
+
+    // Balanceo
+
+    /**
+     * @brief Reorganiza el árbol en uno casi completo (algoritmo de Day-Stout-Warren).
+     * @details
+     * Primero convierte el árbol, tenga la forma que tenga, en una espina
+     * (lista enlazada por la derecha) mediante rotaciones a la derecha; luego
+     * la comprime con rondas de rotaciones a la izquierda hasta dejar todos
+     * los niveles llenos salvo el último. Cuesta O(n) y solo O(1) de memoria
+     * adicional; los agregados se mantienen en cada rotación. Al terminar,
+     * altura() vale floor(log2(n)). No copia ni mueve ningún Estudiante.
+     */
+    void rebalancear();
+
+    // Localidad de memoria
+
+    /**
+     * @brief Reubica todos los nodos en un único bloque contiguo con disposición van Emde Boas.
+     * @details
+     * Tras millones de inserciones los nodos quedan dispersos por el heap y
+     * casi cada paso de un recorrido es un fallo de caché. compactar() reserva
+     * un solo bloque para los n nodos, mueve cada Estudiante (sin copiar sus
+     * cadenas) a su nueva posición y reenlaza los hijos.
+     *
+     * En la disposición van Emde Boas todo subárbol de pocos niveles ocupa un
+     * tramo contiguo: una búsqueda toca O(log_B n) bloques de caché en lugar de
+     * O(log n), y un recorrido completo lee cada tramo de una vez. Un orden
+     * puramente inorden acelera los recorridos pero dispersa los niveles
+     * superiores y empeora las búsquedas, por eso no se usa.
+     *
+     * La forma del árbol no cambia; conviene llamar antes a rebalancear().
+     * Cuesta O(n log log n) y un vector temporal de n punteros. Los nodos
+     * insertados después se reservan de forma normal.
+     */
+    void compactar();
+
+    // División / unión
+
+    /**
+     * @brief Reparte todos los nodos del árbol en dos árboles según un promedio de corte.
+     * @param promedio Promedio de corte en escala 0.0 - 100.0.
+     * @param menores Recibe los estudiantes con promedio menor que el corte.
+     * @param mayores_o_iguales Recibe los estudiantes con promedio mayor o igual al corte.
+     * @details
+     * Los nodos se mueven tal cual (sin copiar Estudiante) y este árbol queda
+     * vacío. Lo que contuvieran antes menores y mayores_o_iguales se libera.
+     * Cuesta O(altura), que es O(log n) mientras el árbol esté balanceado.
+     * Cualquiera de los destinos puede ser este mismo árbol, pero no los dos
+     * el mismo objeto.
+     * @throws std::invalid_argument si menores y mayores_o_iguales son el mismo árbol.
+     */
+    void dividir(double promedio, ArbolBinarioBusqueda& menores, ArbolBinarioBusqueda& mayores_o_iguales);
+
+    /**
+     * @brief Mueve todos los nodos de otro árbol a este.
+     * @param otro Árbol cuyos nodos se incorporan; queda vacío.
+     * @details
+     * Si todas las claves de un árbol son menores que las del otro (el caso
+     * de deshacer un dividir), se extrae el nodo frontera y se usa como nueva
+     * raíz de ambos: O(altura). Si los rangos se solapan, cada nodo de otro se
+     * vuelve a enlazar individualmente; sigue sin copiar Estudiante, pero
+     * cuesta O(m · altura).
+     */
+    void unir(ArbolBinarioBusqueda& otro);
+
+    // Operaciones de conjuntos
+
+    /**
+     * @brief Unión de dos listas de estudiantes.
+     * @param a Primer árbol (no se modifica).
+     * @param b Segundo árbol (no se modifica).
+     * @return Árbol nuevo con los estudiantes que están en a o en b.
+     * @details
+     * A diferencia de unir(otro), no mueve nodos ni vacía ningún árbol: copia
+     * los estudiantes en un árbol nuevo. En las tres operaciones de conjuntos
+     * la pertenencia se decide por ID, no por la clave completa del árbol: un
+     * estudiante cuyo promedio cambió entre ambas listas es el mismo elemento,
+     * y cuando un ID está en ambas se copia la versión de a. Cuestan
+     * O((n + m) log(n + m)) por las búsquedas de ID y construyen el resultado
+     * ya balanceado en un único bloque contiguo, sin inserciones una por una.
+     */
+    static ArbolBinarioBusqueda union_conjuntos(const ArbolBinarioBusqueda& a, const ArbolBinarioBusqueda& b);
+
+    /**
+     * @brief Intersección de dos listas de estudiantes.
+     * @param a Primer árbol.
+     * @param b Segundo árbol.
+     * @return Árbol nuevo con los estudiantes de a cuyo ID también está en b.
+     */
+    static ArbolBinarioBusqueda interseccion(const ArbolBinarioBusqueda& a, const ArbolBinarioBusqueda& b);
+
+    /**
+     * @brief Diferencia de dos listas de estudiantes.
+     * @param a Árbol base.
+     * @param b Árbol cuyos IDs se descartan.
+     * @return Árbol nuevo con los estudiantes de a cuyo ID no está en b.
+     * @details
+     * diferencia(nuestra, registro) da los que el registro dio de baja y
+     * diferencia(registro, nuestra) los que agregó; un cambio de promedio no
+     * aparece en ninguna de las dos (para eso, interseccion y comparar).
+     */
+    static ArbolBinarioBusqueda diferencia(const ArbolBinarioBusqueda& a, const ArbolBinarioBusqueda& b);
+
+#ifdef ABB_MERKLE
+    // Hashes Merkle (solo con ABB_MERKLE)
+
+    /**
+     * @brief Hash de todo el contenido del árbol.
+     * @return 0 si el árbol está vacío.
+     * @details
+     * Dos árboles con los mismos estudiantes (mismo ID, promedio, nombre y
+     * carrera) tienen el mismo hash aunque su forma sea distinta, así que
+     * comprobar que una réplica coincide cuesta O(1).
      */
-    const Estudiante* buscar_por_id(int id);                // no est ordenado por ID
+    std::uint64_t hash_raiz() const;
 
-    // Recorridos recursivos (pblicos)
+    /**
+     * @brief Informa las diferencias entre este árbol y otro.
+     * @param otro Árbol a comparar (por ejemplo, la réplica).
+     * @param visitar Se llama con (propio, ajeno) por cada clave distinta:
+     *        (e, nullptr) si solo está aquí, (nullptr, e) si solo está en otro
+     *        y (e1, e2) si ambos tienen la clave con contenido distinto.
+     * @details
+     * Desciende por los dos árboles a la par y salta todo par de subárboles
+     * con el mismo hash. Si los dos árboles tienen la misma forma (una réplica
+     * que aplica las mismas inserciones), cuesta O(cambios · log n). Donde las
+     * formas divergen, los dos subárboles se comparan mezclando sus inorden,
+     * en tiempo lineal en su tamaño. Las diferencias se informan en orden de clave.
+     */
+    void diferencias(const ArbolBinarioBusqueda& otro,
+        const std::function<void(const Estudiante* propio, const Estudiante* ajeno)>& visitar) const;
+#endif
+
+    // Recorridos recursivos (públicos)
 
     /**
-     * @brief Recorre el rbol en preorden de forma recursiva (pblico).
-     * @param visitar Funcin callback que recibe cada estudiante visitado.
+     * @brief Recorre el árbol en preorden de forma recursiva (público).
+     * @param visitar Función callback que recibe cada estudiante visitado.
      */
     void preorden_rec(const std::function<void(const Estudiante&)>& visitar) const;
 
     /**
-     * @brief Recorre el rbol en inorden de forma recursiva (pblico).
-     * @param visitar Funcin callback que se ejecuta para cada estudiante.
+     * @brief Recorre el árbol en inorden de forma recursiva (público).
+     * @param visitar Función callback que se ejecuta para cada estudiante.
      * @details
      * Este recorrido devuelve los estudiantes en orden ascendente de clave.
      */
     void inorden_rec(const std::function<void(const Estudiante&)>& visitar) const;
 
     /**
-     * @brief Recorre el rbol en postorden de forma recursiva (pblico).
-     * @param visitar Funcin callback para procesar cada estudiante.
+     * @brief Recorre el árbol en postorden de forma recursiva (público).
+     * @param visitar Función callback para procesar cada estudiante.
      */
     void postorden_rec(const std::function<void(const Estudiante&)>& visitar) const;
 
     // Recorridos iterativos
 
     /**
-     * @brief Recorre el rbol en preorden de forma iterativa.
-     * @param visitar Funcin callback que se invoca para cada estudiante visitado.
+     * @brief Recorre el árbol en preorden de forma iterativa.
+     * @param visitar Función callback que se invoca para cada estudiante visitado.
      * @details
-     * Implementado usualmente con una pila explcita en lugar de recursin.
+     * Implementado usualmente con una pila explícita en lugar de recursión.
      */
     void preorden_it(const std::function<void(const Estudiante&)>& visitar) const;
 
     /**
-     * @brief Recorre el rbol en inorden de forma iterativa.
-     * @param visitar Funcin callback que procesa cada estudiante.
+     * @brief Recorre el árbol en inorden de forma iterativa.
+     * @param visitar Función callback que procesa cada estudiante.
      */
     void inorden_it(const std::function<void(const Estudiante&)>& visitar) const;
 
     /**
-     * @brief Recorre el rbol en postorden de forma iterativa.
-     * @param visitar Funcin callback que procesa cada estudiante.
+     * @brief Recorre el árbol en postorden de forma iterativa.
+     * @param visitar Función callback que procesa cada estudiante.
      */
     void postorden_it(const std::function<void(const Estudiante&)>& visitar) const;
 
+    // Recorridos parciales (top-K / bottom-K)
+
+    /**
+     * @brief Visita los k estudiantes con mayor promedio, de mayor a menor.
+     * @param k Cantidad máxima de estudiantes a visitar.
+     * @param visitar Función callback para cada estudiante.
+     * @details
+     * Hace un inorden inverso (derecho, nodo, izquierdo) con pila explícita y
+     * se detiene al visitar k estudiantes, por lo que cuesta O(altura + k)
+     * en lugar de recorrer los n nodos. Los empates de promedio se
+     * ordenan por ID descendente.
+     */
+    void top_k(int k, const std::function<void(const Estudiante&)>& visitar) const;
+
+    /**
+     * @brief Visita los k estudiantes con menor promedio, de menor a mayor.
+     * @param k Cantidad máxima de estudiantes a visitar.
+     * @param visitar Función callback para cada estudiante.
+     * @details
+     * Inorden iterativo que se detiene tras k visitas: O(altura + k).
+     */
+    void bottom_k(int k, const std::function<void(const Estudiante&)>& visitar) const;
+
+    // Paginación
+
+    /**
+     * @brief Visita la página de hasta n estudiantes que sigue al cursor.
+     * @param cursor Posición devuelta por la llamada anterior (o uno nuevo para empezar).
+     * @param n Tamaño de la página.
+     * @param visitar Función callback para cada estudiante, en orden ascendente.
+     * @return Cursor para pedir la página siguiente; si no se visitó a nadie,
+     *         el mismo cursor recibido.
+     * @details
+     * Se ubica con un descenso de cota inferior desde la raíz, apilando solo
+     * los ancestros que quedan pendientes en el inorden, y continúa como
+     * bottom_k: cada página cuesta O(altura + n), sin importar cuántas páginas
+     * se hayan leído antes. Una página con menos de n estudiantes es la última.
+     */
+    CursorPagina siguiente_pagina(const CursorPagina& cursor, int n, const std::function<void(const Estudiante&)>& visitar) const;
+
     // Por niveles (BFS)
 
     /**
-     * @brief Recorre el rbol por niveles (BFS).
-     * @param visitar Funcin que recibe el estudiante y el nivel en el que se encuentra.
+     * @brief Recorre el árbol por niveles (BFS).
+     * @param visitar Función que recibe el estudiante y el nivel en el que se encuentra.
      * @details
-     * El nivel de la raz suele considerarse 0 o 1 segn la implementacin interna.
-     * Este recorrido facilita visualizar la estructura del rbol por capas.
+     * El nivel de la raíz suele considerarse 0 o 1 según la implementación interna.
+     * Este recorrido facilita visualizar la estructura del árbol por capas.
      */
     void por_niveles(const std::function<void(const Estudiante&, int nivel)>& visitar) const;
 
-    // Mtricas
+    // Métricas
 
     /**
-     * @brief Obtiene la altura del rbol.
-     * @return Altura del rbol, donde un rbol vaco tiene altura 0.
+     * @brief Obtiene la altura del árbol.
+     * @return Altura del árbol, donde un árbol vacío tiene altura 0.
      */
     int altura() const;
 
     /**
-     * @brief Cuenta el nmero total de nodos del rbol.
+     * @brief Cuenta el número total de nodos del árbol.
      * @return Cantidad de nodos almacenados.
      */
     int contar_nodos() const;
 
     /**
-     * @brief Cuenta el nmero de hojas del rbol.
+     * @brief Cuenta el número de hojas del árbol.
      * @return Cantidad de nodos hoja (sin hijos).
      */
     int contar_hojas() const;
 
     /**
-     * @brief Cuenta el nmero de nodos internos del rbol.
+     * @brief Cuenta el número de nodos internos del árbol.
      * @return Cantidad de nodos que tienen al menos un hijo.
      */
     int contar_internos() const;
 
     /**
-     * @brief Calcula el ancho mximo del rbol.
-     * @return Nmero mximo de nodos encontrados en un mismo nivel.
+     * @brief Calcula el ancho máximo del árbol.
+     * @return Número máximo de nodos encontrados en un mismo nivel.
      * @details
-     * El ancho mximo es til para estimar el "tamao horizontal" del rbol.
+     * El ancho máximo es útil para estimar el "tamaño horizontal" del árbol.
      */
     int ancho_maximo() const;
 
+    /**
+     * @brief Calcula cantidad, media y varianza de los promedios en un rango.
+     * @param minimo Promedio mínimo del rango (incluido).
+     * @param maximo Promedio máximo del rango (incluido).
+     * @return Estadísticas de los estudiantes con promedio en [minimo, maximo].
+     * @details
+     * Usa los agregados de subárbol: combina los nodos frontera de dos
+     * descensos (claves <= maximo menos claves < minimo) sin visitar a los
+     * estudiantes del rango. Cuesta O(altura), es decir O(log n) en un árbol
+     * razonablemente balanceado, sin importar cuántos estudiantes haya en el rango.
+     * @note Como las búsquedas, asume que el árbol no está reflejado.
+     */
+    EstadisticasRango estadisticas_rango(double minimo, double maximo) const;
+
     // Reflejo
 
     /**
-     * @brief Genera el reflejo del rbol binario de bsqueda.
+     * @brief Genera el reflejo del árbol binario de búsqueda.
      * @details
      * Intercambia recursivamente los hijos izquierdo y derecho de todos
-     * los nodos, produciendo una imagen especular del rbol.
+     * los nodos, produciendo una imagen especular del árbol.
      */
     void reflejar();
 
     // Estado
 
     /**
-     * @brief Verifica si el rbol est vaco.
-     * @return true si la raz es nullptr, false en caso contrario.
+     * @brief Verifica si el árbol está vacío.
+     * @return true si la raíz es nullptr, false en caso contrario.
      */
     bool vacio() const;
+
+    // Instrumentación
+
+    /**
+     * @brief Obtiene los contadores de operaciones y el histograma de profundidad.
+     * @return Referencia constante a las estadísticas acumuladas.
+     * @details
+     * Si el proyecto no se compiló con ABB_ESTADISTICAS, el campo habilitadas
+     * es false y todos los contadores valen cero.
+     */
+    const EstadisticasArbol& estadisticas() const;
+
+    /**
+     * @brief Pone en cero todos los contadores y el histograma.
+     */
+    void reiniciar_estadisticas();
 };
@@ -0,0 +1,691 @@
+// Benchmark.cpp : mide el rendimiento de ArbolBinarioBusqueda con distintas distribuciones de claves.
+//
+// Uso:
+//   Proyecto2_Benchmark [--max N] [--semilla S] [--salida archivo.json]
+//
+// El resultado se emite en JSON (por defecto a la salida estándar) para poder
+// compararlo entre versiones y detectar regresiones.
+
+#include "ArbolBMasDisco.h"
+#include "ArbolBinarioBusqueda.h"
+#include "IndiceCubetas.h"
+#include "Replicacion.h"
+#include "RosterParticionado.h"
+#include "TablaColumnar.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#include <fcntl.h>
+#include <io.h>
+#include <malloc.h>
+#pragma comment(lib, "psapi.lib")
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#include <malloc/malloc.h>
+#include <unistd.h>
+#else
+#include <malloc.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace {
+
+    /**
+     * @brief Tamaño máximo para las distribuciones que degeneran el árbol en una lista.
+     * @details
+     * Con claves ordenadas o inversas el árbol no balanceado tiene altura n:
+     * la inserción cuesta O(n^2) y los recorridos recursivos usan n marcos de pila,
+     * por lo que tamaños mayores desbordarían la pila de 1 MB de Windows.
+     */
+    const int LIMITE_DEGENERADO = 10000;
+
+    /**
+     * @brief Acumulador que evita que el compilador elimine las operaciones medidas.
+     */
+    volatile long long sumidero = 0;
+
+    /**
+     * @brief Resultado de medir una operación sobre un tamaño y distribución.
+     */
+    struct Medicion {
+        string distribucion;
+        int n;
+        string operacion;
+        long long operaciones;
+        double nanosegundos_totales;
+        size_t memoria_pico_caso_bytes;
+    };
+
+    /**
+     * @brief Caso que no se ejecutó y el motivo.
+     */
+    struct Omitido {
+        string distribucion;
+        int n;
+        string motivo;
+    };
+
+    /**
+     * @brief Obtiene la memoria residente actual del proceso.
+     * @return Bytes del conjunto residente, o 0 si no se pudo leer.
+     */
+    size_t memoria_residente_bytes() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS contadores;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &contadores, sizeof(contadores))) {
+            return static_cast<size_t>(contadores.WorkingSetSize);
+        }
+        return 0;
+#elif defined(__APPLE__)
+        mach_task_basic_info_data_t informacion;
+        mach_msg_type_number_t cantidad = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&informacion), &cantidad) != KERN_SUCCESS) return 0;
+        return static_cast<size_t>(informacion.resident_size);
+#else
+        ifstream statm("/proc/self/statm");
+        size_t paginas_totales = 0, paginas_residentes = 0;
+        if (!(statm >> paginas_totales >> paginas_residentes)) return 0;
+        return paginas_residentes * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+    }
+
+    /**
+     * @brief Devuelve al sistema operativo la memoria libre que retiene el asignador.
+     * @details
+     * Sin esto, los nodos liberados por el caso anterior siguen residentes y
+     * el caso siguiente los reutiliza sin que la memoria residente crezca.
+     */
+    void liberar_memoria_retenida() {
+#ifdef _WIN32
+        _heapmin();
+#elif defined(__APPLE__)
+        malloc_zone_pressure_relief(nullptr, 0);
+#elif defined(__GLIBC__)
+        malloc_trim(0);
+#endif
+    }
+
+    /**
+     * @brief Reinicia el pico de memoria residente que lleva el sistema operativo.
+     * @return true si se pudo (Linux, escribiendo "5" en /proc/self/clear_refs).
+     * @details
+     * ru_maxrss y PeakWorkingSetSize son máximos de todo el proceso que nunca
+     * bajan; sin reiniciarlos, cada caso heredaría el pico del mayor anterior.
+     */
+    bool reiniciar_pico_residente() {
+#if defined(_WIN32) || defined(__APPLE__)
+        return false;
+#else
+        ofstream clear_refs("/proc/self/clear_refs");
+        clear_refs << "5";
+        clear_refs.flush();
+        return static_cast<bool>(clear_refs);
+#endif
+    }
+
+    /**
+     * @brief Pico de memoria residente desde el último reinicio (VmHWM en Linux).
+     * @return Bytes, o 0 si la plataforma no lo ofrece.
+     */
+    size_t pico_residente_bytes() {
+#if defined(_WIN32) || defined(__APPLE__)
+        return 0;
+#else
+        ifstream status("/proc/self/status");
+        string linea;
+        while (getline(status, linea)) {
+            if (linea.rfind("VmHWM:", 0) == 0) return static_cast<size_t>(strtoull(linea.c_str() + 6, nullptr, 10)) * 1024;
+        }
+        return 0;
+#endif
+    }
+
+    /**
+     * @brief Mide el tiempo de ejecución de una función en nanosegundos.
+     * @param funcion Código a medir.
+     * @return Nanosegundos transcurridos.
+     */
+    template <typename Funcion>
+    double medir_ns(Funcion funcion) {
+        auto inicio = chrono::steady_clock::now();
+        funcion();
+        auto fin = chrono::steady_clock::now();
+        return chrono::duration<double, nano>(fin - inicio).count();
+    }
+
+    /**
+     * @brief Genera los estudiantes de una distribución de promedios.
+     * @param distribucion "aleatoria", "ordenada", "inversa" o "duplicados".
+     * @param n Cantidad de estudiantes.
+     * @param generador Generador pseudoaleatorio.
+     * @return Estudiantes en el orden en que se insertarán.
+     * @details
+     * - aleatoria: promedios uniformes en centésimas e IDs únicos barajados.
+     * - ordenada / inversa: claves (promedio, ID) estrictamente crecientes o decrecientes.
+     * - duplicados: solo 16 promedios distintos; el ID desempata.
+     */
+    vector<Estudiante> generar_estudiantes(const string& distribucion, int n, mt19937_64& generador) {
+        static const string carreras[8] = { "Ingeniería","Medicina","Derecho","Arquitectura",
+                                            "Economía","Psicología","Biología","Matemática" };
+        vector<int> ids(n);
+        iota(ids.begin(), ids.end(), 1);
+        if (distribucion == "aleatoria" || distribucion == "duplicados") {
+            shuffle(ids.begin(), ids.end(), generador);
+        }
+
+        uniform_int_distribution<int> centesimas(0, 10000);
+        uniform_int_distribution<int> grupo(0, 15);
+
+        vector<Estudiante> estudiantes;
+        estudiantes.reserve(n);
+        for (int indice = 0; indice < n; ++indice) {
+            int clave;
+            if (distribucion == "ordenada") clave = static_cast<int>(10000LL * indice / n);
+            else if (distribucion == "inversa") clave = static_cast<int>(10000LL * (n - 1 - indice) / n);
+            else if (distribucion == "duplicados") clave = 6000 + grupo(generador) * 250;
+            else clave = centesimas(generador);
+
+            int id = (distribucion == "inversa") ? n - indice : ids[indice];
+            estudiantes.emplace_back(id, "Estudiante " + to_string(id), carreras[id % 8], clave / 100.0);
+        }
+        return estudiantes;
+    }
+
+    /**
+     * @brief Genera consultas por promedio con popularidad tipo Zipf.
+     * @param estudiantes Estudiantes insertados.
+     * @param cantidad Cantidad de consultas.
+     * @param generador Generador pseudoaleatorio.
+     * @return Promedios a consultar.
+     * @details
+     * Se eligen al azar hasta 100 000 estudiantes y el de rango r se consulta
+     * con probabilidad proporcional a 1/r (exponente 1): unos pocos cientos
+     * concentran la mayoría de las consultas, como ocurre con los candidatos
+     * a beca.
+     */
+    vector<double> generar_consultas_zipf(const vector<Estudiante>& estudiantes, int cantidad, mt19937_64& generador) {
+        const int universo = min(static_cast<int>(estudiantes.size()), 100000);
+        uniform_int_distribution<size_t> posicion(0, estudiantes.size() - 1);
+        vector<double> candidatos(universo);
+        vector<double> acumulada(universo);
+        double total = 0.0;
+        for (int rango = 0; rango < universo; ++rango) {
+            candidatos[rango] = estudiantes[posicion(generador)].promedio();
+            total += 1.0 / (rango + 1);
+            acumulada[rango] = total;
+        }
+
+        uniform_real_distribution<double> uniforme(0.0, total);
+        vector<double> consultas(cantidad);
+        for (double& consulta : consultas) {
+            const size_t rango = upper_bound(acumulada.begin(), acumulada.end(), uniforme(generador)) - acumulada.begin();
+            consulta = candidatos[min(rango, candidatos.size() - 1)];
+        }
+        return consultas;
+    }
+
+    /**
+     * @brief Ejecuta todas las mediciones de una distribución y tamaño.
+     * @param distribucion Nombre de la distribución.
+     * @param n Cantidad de estudiantes.
+     * @param generador Generador pseudoaleatorio.
+     * @param mediciones Vector donde se agregan los resultados.
+     */
+    void medir_caso(const string& distribucion, int n, mt19937_64& generador, vector<Medicion>& mediciones) {
+        // La memoria se reporta como pico del caso por encima de la residente al
+        // empezarlo. En Linux el pico lo lleva el kernel tras reiniciarlo; en las
+        // demás plataformas se toma el máximo de la residente al final de cada
+        // operación, que no ve picos transitorios dentro de una operación.
+        liberar_memoria_retenida();
+        const size_t memoria_base = memoria_residente_bytes();
+        const bool pico_del_sistema = reiniciar_pico_residente();
+        size_t pico_muestreado = memoria_base;
+
+        vector<Estudiante> estudiantes = generar_estudiantes(distribucion, n, generador);
+
+        auto registrar = [&](const string& operacion, long long operaciones, double ns) {
+            pico_muestreado = max(pico_muestreado, memoria_residente_bytes());
+            const size_t pico = pico_del_sistema ? max(pico_muestreado, pico_residente_bytes()) : pico_muestreado;
+            mediciones.push_back({ distribucion, n, operacion, operaciones, ns, pico > memoria_base ? pico - memoria_base : 0 });
+            cerr << distribucion << " n=" << n << " " << operacion << ": "
+                << (ns / max(1LL, operaciones)) << " ns/op\n";
+        };
+
+        ArbolBinarioBusqueda arbol;
+        registrar("insertar", n, medir_ns([&] {
+            for (const Estudiante& estudiante : estudiantes) arbol.insertar(estudiante);
+            }));
+
+        {
+            // Carga por movimiento: la copia del vector se hace fuera de la medición.
+            vector<Estudiante> copia = estudiantes;
+            ArbolBinarioBusqueda arbol_movido;
+            registrar("insertar_mover", n, medir_ns([&] {
+                for (Estudiante& estudiante : copia) arbol_movido.insertar(std::move(estudiante));
+                }));
+        }
+
+        {
+            // Carga masiva particionada: una partición por núcleo disponible.
+            const size_t particiones = max(1u, thread::hardware_concurrency());
+            RosterParticionado por_rango(particiones, ModoParticion::PorRangoPromedio);
+            registrar("roster_cargar_rango", n, medir_ns([&] { por_rango.cargar_masivo(estudiantes); }));
+            RosterParticionado por_hash(particiones, ModoParticion::PorHashId);
+            registrar("roster_cargar_hash", n, medir_ns([&] { por_hash.cargar_masivo(estudiantes); }));
+        }
+
+        // Consultas sobre claves existentes, en orden aleatorio.
+        const int consultas_promedio = min(n, 100000);
+        vector<double> promedios_consulta(consultas_promedio);
+        uniform_int_distribution<int> posicion(0, n - 1);
+        for (double& promedio : promedios_consulta) promedio = estudiantes[posicion(generador)].promedio();
+
+        registrar("buscar_por_promedio", consultas_promedio, medir_ns([&] {
+            for (double promedio : promedios_consulta) {
+                const Estudiante* encontrado = arbol.buscar_por_promedio(promedio);
+                sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+            }
+            }));
+
+        // Acceso sesgado (Zipf): árbol sin autoajuste contra el mismo árbol en modo splay.
+        vector<double> promedios_zipf = generar_consultas_zipf(estudiantes, consultas_promedio, generador);
+        registrar("buscar_zipf", consultas_promedio, medir_ns([&] {
+            for (double promedio : promedios_zipf) {
+                const Estudiante* encontrado = arbol.buscar_por_promedio(promedio);
+                sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+            }
+            }));
+        {
+            ArbolBinarioBusqueda arbol_splay;
+            arbol_splay.set_modo_splay(true);
+            registrar("insertar_splay", n, medir_ns([&] {
+                for (const Estudiante& estudiante : estudiantes) arbol_splay.insertar(estudiante);
+                }));
+            registrar("buscar_zipf_splay", consultas_promedio, medir_ns([&] {
+                for (double promedio : promedios_zipf) {
+                    const Estudiante* encontrado = arbol_splay.buscar_por_promedio(promedio);
+                    sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+                }
+                }));
+        }
+
+        registrar("buscar_lote", consultas_promedio, medir_ns([&] {
+            vector<const Estudiante*> encontrados = arbol.buscar_lote(promedios_consulta);
+            for (const Estudiante* encontrado : encontrados) sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+            }));
+
+        // buscar_por_id es O(n): se limita la cantidad de consultas para acotar el tiempo.
+        const int consultas_id = max(5, min(1000, 20000000 / n));
+        vector<int> ids_consulta(consultas_id);
+        for (int& id : ids_consulta) id = estudiantes[posicion(generador)].id();
+
+        registrar("buscar_por_id", consultas_id, medir_ns([&] {
+            for (int id : ids_consulta) {
+                const Estudiante* encontrado = arbol.buscar_por_id(id);
+                sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+            }
+            }));
+
+        registrar("buscar_lote_por_id", consultas_id, medir_ns([&] {
+            vector<const Estudiante*> encontrados = arbol.buscar_lote_por_id(ids_consulta);
+            for (const Estudiante* encontrado : encontrados) sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+            }));
+
+        // IDs ausentes: sin filtro cada fallo recorre todo el árbol; con el
+        // filtro de Bloom la mayoría se descarta leyendo un solo bloque.
+        vector<int> ids_ausentes(consultas_promedio);
+        iota(ids_ausentes.begin(), ids_ausentes.end(), n + 1);
+        registrar("buscar_por_id_ausente", consultas_id, medir_ns([&] {
+            for (int indice = 0; indice < consultas_id; ++indice) sumidero = sumidero + (arbol.buscar_por_id(ids_ausentes[indice]) ? 1 : 0);
+            }));
+        registrar("activar_filtro_ids", n, medir_ns([&] { arbol.activar_filtro_ids(static_cast<size_t>(n)); }));
+        registrar("buscar_por_id_ausente_filtrado", consultas_promedio, medir_ns([&] {
+            for (int id : ids_ausentes) sumidero = sumidero + (arbol.buscar_por_id(id) ? 1 : 0);
+            }));
+        arbol.desactivar_filtro_ids();
+
+        // Índice de nombres: la construcción es O(n); cada consulta trae hasta 10 nombres.
+        registrar("indexar_nombres", n, medir_ns([&] { sumidero = sumidero + static_cast<long long>(arbol.buscar_por_prefijo("", 1).size()); }));
+        registrar("buscar_por_prefijo_10", consultas_promedio, medir_ns([&] {
+            for (int consulta = 0; consulta < consultas_promedio; ++consulta) {
+                const string prefijo = "estudiante " + to_string(ids_consulta[consulta % consultas_id]);
+                sumidero = sumidero + static_cast<long long>(arbol.buscar_por_prefijo(prefijo, 10).size());
+            }
+            }));
+
+        // Índice por carrera: construcción O(n log n), luego top-10 y rangos de un punto dentro de una carrera.
+        const string carrera_consulta = estudiantes[0].carrera();
+        auto visitar_carrera = [&](const Estudiante& estudiante) { sumidero = sumidero + estudiante.id(); };
+        registrar("indexar_carreras", n, medir_ns([&] { arbol.top_k_por_carrera(carrera_consulta, 1, visitar_carrera); }));
+        registrar("top_k_carrera_10", consultas_promedio, medir_ns([&] {
+            for (int consulta = 0; consulta < consultas_promedio; ++consulta) arbol.top_k_por_carrera(carrera_consulta, 10, visitar_carrera);
+            }));
+        registrar("rango_carrera", consultas_promedio, medir_ns([&] {
+            for (double promedio : promedios_consulta) arbol.rango_por_carrera(carrera_consulta, promedio, promedio + 1.0, visitar_carrera);
+            }));
+
+        // Recorridos: una operación equivale a visitar un estudiante.
+        long long visitados = 0;
+        auto visitar = [&](const Estudiante& estudiante) { visitados += estudiante.id(); };
+        registrar("preorden_rec", n, medir_ns([&] { arbol.preorden_rec(visitar); }));
+        registrar("inorden_rec", n, medir_ns([&] { arbol.inorden_rec(visitar); }));
+        registrar("postorden_rec", n, medir_ns([&] { arbol.postorden_rec(visitar); }));
+        registrar("preorden_it", n, medir_ns([&] { arbol.preorden_it(visitar); }));
+        registrar("inorden_it", n, medir_ns([&] { arbol.inorden_it(visitar); }));
+        registrar("postorden_it", n, medir_ns([&] { arbol.postorden_it(visitar); }));
+        registrar("por_niveles", n, medir_ns([&] {
+            arbol.por_niveles([&](const Estudiante& estudiante, int nivel) { visitados += estudiante.id() + nivel; });
+            }));
+        registrar("top_k_100", 100, medir_ns([&] { arbol.top_k(100, visitar); }));
+        registrar("bottom_k_100", 100, medir_ns([&] { arbol.bottom_k(100, visitar); }));
+        registrar("paginar_50", n, medir_ns([&] {
+            // Cada página pasa por el texto opaco, como lo haría un cliente web.
+            string cursor;
+            for (int pagina = 0; pagina * 50 < n; ++pagina) {
+                cursor = arbol.siguiente_pagina(CursorPagina::decodificar(cursor), 50, visitar).codificar();
+            }
+            }));
+        sumidero = sumidero + visitados;
+
+        // Métricas: una operación equivale a una llamada completa.
+        registrar("altura", 1, medir_ns([&] { sumidero = sumidero + arbol.altura(); }));
+        registrar("contar_nodos", 1, medir_ns([&] { sumidero = sumidero + arbol.contar_nodos(); }));
+        registrar("contar_hojas", 1, medir_ns([&] { sumidero = sumidero + arbol.contar_hojas(); }));
+        registrar("contar_internos", 1, medir_ns([&] { sumidero = sumidero + arbol.contar_internos(); }));
+        registrar("ancho_maximo", 1, medir_ns([&] { sumidero = sumidero + arbol.ancho_maximo(); }));
+        registrar("estadisticas_rango", consultas_promedio, medir_ns([&] {
+            for (int consulta = 0; consulta < consultas_promedio; ++consulta) {
+                const double inicio = promedios_consulta[consulta];
+                sumidero = sumidero + arbol.estadisticas_rango(inicio, inicio + 20.0).cantidad;
+            }
+            }));
+        registrar("reflejar", 2, medir_ns([&] { arbol.reflejar(); arbol.reflejar(); }));
+
+        // Analítica columnar: una operación equivale a una fila procesada.
+        TablaColumnar tabla;
+        registrar("tabla_cargar", n, medir_ns([&] { tabla.cargar_desde(arbol); }));
+        registrar("tabla_resumir", n, medir_ns([&] { sumidero = sumidero + tabla.resumir().suma_cent; }));
+        registrar("tabla_resumir_carrera", n, medir_ns([&] {
+            sumidero = sumidero + tabla.resumir(estudiantes[0].codigo_carrera()).suma_cent;
+            }));
+        registrar("tabla_histograma", n, medir_ns([&] { sumidero = sumidero + tabla.histograma(100)[0]; }));
+
+        // Reparación DSW del árbol ya construido y las mismas consultas sobre el resultado.
+        registrar("rebalancear", n, medir_ns([&] { arbol.rebalancear(); }));
+        registrar("buscar_por_promedio_rebalanceado", consultas_promedio, medir_ns([&] {
+            for (double promedio : promedios_consulta) {
+                const Estudiante* encontrado = arbol.buscar_por_promedio(promedio);
+                sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+            }
+            }));
+
+        // Compactación: los mismos nodos en un bloque contiguo en inorden.
+        registrar("compactar", n, medir_ns([&] { arbol.compactar(); }));
+        registrar("inorden_it_compactado", n, medir_ns([&] { arbol.inorden_it(visitar); }));
+        {
+            // Copia profunda; la destrucción de la copia queda fuera de la medición.
+            ArbolBinarioBusqueda copia;
+            registrar("clonar", n, medir_ns([&] { copia = arbol.clonar(); }));
+        }
+
+        {
+            // Operaciones de conjuntos contra una lista con la mitad de los estudiantes.
+            ArbolBinarioBusqueda mitad;
+            for (size_t indice = 0; indice < estudiantes.size(); indice += 2) mitad.insertar(estudiantes[indice]);
+            const long long operaciones = n + mitad.contar_nodos();
+            registrar("conjuntos_unir", operaciones, medir_ns([&] {
+                sumidero = sumidero + ArbolBinarioBusqueda::union_conjuntos(arbol, mitad).contar_nodos();
+                }));
+            registrar("conjuntos_interseccion", operaciones, medir_ns([&] {
+                sumidero = sumidero + ArbolBinarioBusqueda::interseccion(arbol, mitad).contar_nodos();
+                }));
+            registrar("conjuntos_diferencia", operaciones, medir_ns([&] {
+                sumidero = sumidero + ArbolBinarioBusqueda::diferencia(arbol, mitad).contar_nodos();
+                }));
+        }
+
+#ifdef ABB_MERKLE
+        {
+            // Réplica con la misma forma y 10 cambios: el diff solo baja por los caminos modificados.
+            ArbolBinarioBusqueda replica = arbol.clonar();
+            for (int cambio = 0; cambio < 10; ++cambio) replica.emplazar(n + 1 + cambio, "Replica", "Derecho", 50.0 + cambio);
+            registrar("merkle_hash_raiz", 1, medir_ns([&] { sumidero = sumidero + static_cast<long long>(replica.hash_raiz() == arbol.hash_raiz()); }));
+            registrar("merkle_diferencias_10", 10, medir_ns([&] {
+                arbol.diferencias(replica, [&](const Estudiante*, const Estudiante* ajeno) { sumidero = sumidero + (ajeno ? ajeno->id() : 0); });
+                }));
+        }
+#endif
+        {
+            // Replicación por tubería: inserciones en el principal aplicadas por un seguidor en otro hilo.
+            int descriptores[2];
+#ifdef _WIN32
+            const bool abierta = _pipe(descriptores, 1 << 16, _O_BINARY) == 0;
+#else
+            const bool abierta = pipe(descriptores) == 0;
+#endif
+            if (abierta) {
+                ArbolBinarioBusqueda principal, replica;
+                registrar("replicar", n, medir_ns([&] {
+                    thread seguidor([&] { SeguidorReplicacion(descriptores[0], replica).aplicar_hasta_cierre(); });
+                    exception_ptr error;
+                    {
+                        EmisorReplicacion emisor(descriptores[1]);
+                        emisor.conectar(principal);
+                        for (const Estudiante& estudiante : estudiantes) principal.insertar(estudiante);
+                        error = principal.error_observador();
+                        principal.set_observador_cambios(nullptr);
+                    }
+#ifdef _WIN32
+                    _close(descriptores[1]);
+#else
+                    close(descriptores[1]);
+#endif
+                    seguidor.join();
+                    if (error) rethrow_exception(error);
+                    }));
+                sumidero = sumidero + static_cast<long long>(replica.contar_nodos());
+#ifdef _WIN32
+                _close(descriptores[0]);
+#else
+                close(descriptores[0]);
+#endif
+            }
+        }
+        {
+            // Árbol B+ en disco con un pool de 256 páginas (1 MB); los archivos se borran al terminar.
+            const string ruta = (filesystem::temp_directory_path() / "abb_benchmark_bmas").string();
+            filesystem::remove(ruta + ".idx");
+            filesystem::remove(ruta + ".dat");
+            {
+                ArbolBMasDisco disco(ruta, 256);
+                registrar("bmas_cargar", n, medir_ns([&] { disco.cargar_desde(arbol); disco.vaciar(); }));
+                registrar("bmas_buscar_por_promedio", consultas_promedio, medir_ns([&] {
+                    for (double promedio : promedios_consulta) {
+                        optional<Estudiante> encontrado = disco.buscar_por_promedio(promedio);
+                        sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+                    }
+                    }));
+                registrar("bmas_estadisticas_rango", consultas_promedio, medir_ns([&] {
+                    for (int consulta = 0; consulta < consultas_promedio; ++consulta) {
+                        sumidero = sumidero + disco.estadisticas_rango(promedios_consulta[consulta], promedios_consulta[consulta] + 1.0).cantidad;
+                    }
+                    }));
+                registrar("bmas_inorden", n, medir_ns([&] { disco.inorden(visitar); }));
+            }
+            filesystem::remove(ruta + ".idx");
+            filesystem::remove(ruta + ".dat");
+        }
+        {
+            // Índice de cubetas: las mismas consultas que el árbol sobre el dominio 0 - 10000.
+            IndiceCubetas cubetas;
+            registrar("cubetas_insertar", n, medir_ns([&] {
+                for (const Estudiante& estudiante : estudiantes) cubetas.insertar(estudiante);
+                }));
+            registrar("cubetas_buscar_por_promedio", consultas_promedio, medir_ns([&] {
+                for (double promedio : promedios_consulta) {
+                    const Estudiante* encontrado = cubetas.buscar_por_promedio(promedio);
+                    sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+                }
+                }));
+            registrar("cubetas_estadisticas_rango", consultas_promedio, medir_ns([&] {
+                for (int consulta = 0; consulta < consultas_promedio; ++consulta) {
+                    const double inicio = promedios_consulta[consulta];
+                    sumidero = sumidero + cubetas.estadisticas_rango(inicio, inicio + 20.0).cantidad;
+                }
+                }));
+            registrar("cubetas_rango_100", 100, medir_ns([&] {
+                for (int consulta = 0; consulta < 100; ++consulta) {
+                    cubetas.rango(promedios_consulta[consulta], promedios_consulta[consulta] + 1.0, visitar);
+                }
+                }));
+            registrar("cubetas_inorden", n, medir_ns([&] { cubetas.inorden(visitar); }));
+            registrar("cubetas_paginar_50", n, medir_ns([&] {
+                string cursor;
+                for (int pagina = 0; pagina * 50 < n; ++pagina) {
+                    cursor = cubetas.siguiente_pagina(CursorPagina::decodificar(cursor), 50, visitar).codificar();
+                }
+                }));
+        }
+        registrar("buscar_por_promedio_compactado", consultas_promedio, medir_ns([&] {
+            for (double promedio : promedios_consulta) {
+                const Estudiante* encontrado = arbol.buscar_por_promedio(promedio);
+                sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+            }
+            }));
+
+        // Índice aprendido sobre el árbol ya compactado.
+        registrar("congelar", n, medir_ns([&] { arbol.congelar(); }));
+        registrar("buscar_por_promedio_congelado", consultas_promedio, medir_ns([&] {
+            for (double promedio : promedios_consulta) {
+                const Estudiante* encontrado = arbol.buscar_por_promedio(promedio);
+                sumidero = sumidero + (encontrado ? encontrado->id() : 0);
+            }
+            }));
+        registrar("paginar_50_congelado", n, medir_ns([&] {
+            string cursor;
+            for (int pagina = 0; pagina * 50 < n; ++pagina) {
+                cursor = arbol.siguiente_pagina(CursorPagina::decodificar(cursor), 50, visitar).codificar();
+            }
+            }));
+    }
+
+    /**
+     * @brief Escapa una cadena para incluirla en JSON.
+     * @param texto Cadena original.
+     * @return Cadena entre comillas con los caracteres especiales escapados.
+     */
+    string json_cadena(const string& texto) {
+        string salida = "\"";
+        for (char caracter : texto) {
+            if (caracter == '"' || caracter == '\\') salida += '\\';
+            salida += caracter;
+        }
+        return salida + "\"";
+    }
+
+    /**
+     * @brief Escribe los resultados en formato JSON.
+     * @param salida Flujo de destino.
+     * @param semilla Semilla usada en la ejecución.
+     * @param mediciones Resultados medidos.
+     * @param omitidos Casos no ejecutados.
+     */
+    void escribir_json(ostream& salida, uint64_t semilla, const vector<Medicion>& mediciones, const vector<Omitido>& omitidos) {
+        salida << "{\n  \"benchmark\": \"ArbolBinarioBusqueda\",\n"
+            << "  \"semilla\": " << semilla << ",\n"
+            << "  \"resultados\": [\n";
+        for (size_t indice = 0; indice < mediciones.size(); ++indice) {
+            const Medicion& medicion = mediciones[indice];
+            const double ns_por_op = medicion.nanosegundos_totales / max(1LL, medicion.operaciones);
+            const double ops_por_segundo = medicion.nanosegundos_totales > 0
+                ? medicion.operaciones * 1e9 / medicion.nanosegundos_totales : 0.0;
+            salida << "    {\"distribucion\": " << json_cadena(medicion.distribucion)
+                << ", \"n\": " << medicion.n
+                << ", \"operacion\": " << json_cadena(medicion.operacion)
+                << ", \"operaciones\": " << medicion.operaciones
+                << ", \"ns_totales\": " << medicion.nanosegundos_totales
+                << ", \"ns_por_op\": " << ns_por_op
+                << ", \"ops_por_segundo\": " << ops_por_segundo
+                << ", \"memoria_pico_caso_bytes\": " << medicion.memoria_pico_caso_bytes << "}"
+                << (indice + 1 < mediciones.size() ? ",\n" : "\n");
+        }
+        salida << "  ],\n  \"omitidos\": [\n";
+        for (size_t indice = 0; indice < omitidos.size(); ++indice) {
+            const Omitido& omitido = omitidos[indice];
+            salida << "    {\"distribucion\": " << json_cadena(omitido.distribucion)
+                << ", \"n\": " << omitido.n
+                << ", \"motivo\": " << json_cadena(omitido.motivo) << "}"
+                << (indice + 1 < omitidos.size() ? ",\n" : "\n");
+        }
+        salida << "  ]\n}\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    int tamano_maximo = 1000000;
+    uint64_t semilla = 42;
+    string archivo_salida;
+
+    for (int indice = 1; indice < argc; ++indice) {
+        string argumento = argv[indice];
+        if (argumento == "--max" && indice + 1 < argc) tamano_maximo = atoi(argv[++indice]);
+        else if (argumento == "--semilla" && indice + 1 < argc) semilla = strtoull(argv[++indice], nullptr, 10);
+        else if (argumento == "--salida" && indice + 1 < argc) archivo_salida = argv[++indice];
+        else {
+            cerr << "Uso: " << argv[0] << " [--max N] [--semilla S] [--salida archivo.json]\n";
+            return 1;
+        }
+    }
+
+    const int tamanos[] = { 1000, 10000, 100000, 1000000, 10000000 };
+    const string distribuciones[] = { "aleatoria", "ordenada", "inversa", "duplicados" };
+
+    mt19937_64 generador(semilla);
+    vector<Medicion> mediciones;
+    vector<Omitido> omitidos;
+
+    for (const string& distribucion : distribuciones) {
+        for (int n : tamanos) {
+            if (n > tamano_maximo) {
+                omitidos.push_back({ distribucion, n, "mayor que --max" });
+                continue;
+            }
+            if ((distribucion == "ordenada" || distribucion == "inversa") && n > LIMITE_DEGENERADO) {
+                omitidos.push_back({ distribucion, n, "arbol degenerado: altura n excede la pila de recursion" });
+                continue;
+            }
+            medir_caso(distribucion, n, generador, mediciones);
+        }
+    }
+
+    if (archivo_salida.empty()) {
+        escribir_json(cout, semilla, mediciones, omitidos);
+    }
+    else {
+        ofstream archivo(archivo_salida);
+        if (!archivo) {
+            cerr << "No se pudo abrir " << archivo_salida << "\n";
+            return 1;
+        }
+        escribir_json(archivo, semilla, mediciones, omitidos);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "DiccionarioCadenas.h"
+#include <limits>
+#include <mutex>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * @brief Constructor por defecto del diccionario.
+ * @details
+ * Reserva la tabla de 65536 punteros (todos nulos) y registra la cadena
+ * vacía para que el código 0 represente "sin valor", que es lo que usa el
+ * constructor por defecto de Estudiante.
+ */
+DiccionarioCadenas::DiccionarioCadenas()
+    : textos_(make_unique<atomic<const string*>[]>(static_cast<size_t>(numeric_limits<uint16_t>::max()) + 1)) {
+    cadenas_.emplace_back();
+    codigos_.emplace(string_view(cadenas_.back()), static_cast<uint16_t>(0));
+    textos_[0].store(&cadenas_.back(), memory_order_release);
+}
+
+/**
+ * @brief Obtiene (o asigna) el código de una cadena.
+ * @param cadena Texto a internar.
+ * @return Código de la cadena.
+ * @details
+ * Primero busca con un candado compartido, que es el caso común; solo si la
+ * cadena es nueva toma el candado exclusivo y vuelve a comprobar antes de
+ * registrarla, por si otro hilo la agregó entre ambas operaciones. El texto
+ * se publica en textos_ al final, cuando ya está completo en cadenas_ (el
+ * deque no mueve los elementos existentes al crecer).
+ */
+uint16_t DiccionarioCadenas::codificar(string_view cadena) {
+    {
+        shared_lock<shared_mutex> lectura(candado_);
+        auto encontrado = codigos_.find(cadena);
+        if (encontrado != codigos_.end()) return encontrado->second;
+    }
+
+    unique_lock<shared_mutex> escritura(candado_);
+    auto encontrado = codigos_.find(cadena);
+    if (encontrado != codigos_.end()) return encontrado->second;
+
+    if (cadenas_.size() > numeric_limits<uint16_t>::max()) {
+        throw length_error("DiccionarioCadenas: se superó el máximo de 65536 cadenas distintas");
+    }
+    const uint16_t codigo = static_cast<uint16_t>(cadenas_.size());
+    cadenas_.emplace_back(cadena);
+    codigos_.emplace(string_view(cadenas_.back()), codigo);
+    textos_[codigo].store(&cadenas_.back(), memory_order_release);
+    return codigo;
+}
+
+/**
+ * @brief Busca el código de una cadena ya internada.
+ * @param cadena Texto a buscar.
+ * @return Código encontrado o std::nullopt si la cadena no está registrada.
+ */
+optional<uint16_t> DiccionarioCadenas::buscar_codigo(string_view cadena) const {
+    shared_lock<shared_mutex> lectura(candado_);
+    auto encontrado = codigos_.find(cadena);
+    if (encontrado == codigos_.end()) return nullopt;
+    return encontrado->second;
+}
+
+/**
+ * @brief Devuelve el texto asociado a un código.
+ * @param codigo Código a traducir.
+ * @return Referencia al texto almacenado en el diccionario.
+ * @throws std::out_of_range si el código todavía no se asignó.
+ */
+const string& DiccionarioCadenas::decodificar(uint16_t codigo) const {
+    const string* texto = textos_[codigo].load(memory_order_acquire);
+    if (texto == nullptr) throw out_of_range("DiccionarioCadenas: código inexistente");
+    return *texto;
+}
+
+/**
+ * @brief Cantidad de cadenas distintas registradas.
+ * @return Número de códigos asignados, incluida la cadena vacía.
+ */
+size_t DiccionarioCadenas::tamano() const {
+    shared_lock<shared_mutex> lectura(candado_);
+    return cadenas_.size();
+}
+
+/**
+ * @brief Diccionario global de carreras.
+ * @return Instancia única, creada en el primer uso (inicialización segura entre hilos).
+ */
+DiccionarioCadenas& DiccionarioCadenas::carreras() {
+    static DiccionarioCadenas diccionario;
+    return diccionario;
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/**
+ * @brief Diccionario que asigna a cada cadena distinta un código entero pequeño.
+ * @details
+ * Se usa para internar valores con pocas variantes, como la carrera de los
+ * estudiantes: cada objeto guarda solo un código de 16 bits y el texto vive una
+ * única vez en este diccionario compartido.
+ *
+ * Las cadenas se almacenan en un std::deque, por lo que las referencias
+ * devueltas por decodificar() permanecen válidas mientras exista el diccionario.
+ * El código 0 está reservado para la cadena vacía. Es seguro usarlo desde
+ * varios hilos. decodificar() no toma ningún candado: lee una tabla fija de
+ * punteros atómicos que codificar() publica al registrar cada cadena, así
+ * que los hilos que solo leen no comparten ninguna línea de caché escrita.
+ * Las búsquedas por texto toman un candado compartido y las altas uno
+ * exclusivo.
+ */
+class DiccionarioCadenas {
+private:
+    /**
+     * @brief Textos internados; la posición en el deque es su código.
+     */
+    std::deque<std::string> cadenas_;
+
+    /**
+     * @brief Tabla código -> texto de 65536 entradas; nullptr si el código no existe.
+     * @details
+     * Cada entrada se escribe una sola vez (con memory_order_release) después
+     * de agregar el texto a cadenas_, y decodificar() la lee con
+     * memory_order_acquire, así que ve el texto completo sin candado.
+     */
+    std::unique_ptr<std::atomic<const std::string*>[]> textos_;
+
+    /**
+     * @brief Índice inverso texto -> código. Las vistas apuntan a cadenas_.
+     */
+    std::unordered_map<std::string_view, std::uint16_t> codigos_;
+
+    /**
+     * @brief Protege cadenas_ y codigos_ ante altas concurrentes (no lo usa decodificar()).
+     */
+    mutable std::shared_mutex candado_;
+
+public:
+    /**
+     * @brief Constructor por defecto; registra la cadena vacía con el código 0.
+     */
+    DiccionarioCadenas();
+
+    DiccionarioCadenas(const DiccionarioCadenas&) = delete;
+    DiccionarioCadenas& operator=(const DiccionarioCadenas&) = delete;
+
+    /**
+     * @brief Obtiene el código de una cadena, registrándola si es nueva.
+     * @param cadena Texto a internar.
+     * @return Código entero asociado a la cadena.
+     * @throws std::length_error si se superan los 65536 textos distintos.
+     */
+    std::uint16_t codificar(std::string_view cadena);
+
+    /**
+     * @brief Busca el código de una cadena sin registrarla.
+     * @param cadena Texto a buscar.
+     * @return El código si la cadena ya está internada, o std::nullopt.
+     */
+    std::optional<std::uint16_t> buscar_codigo(std::string_view cadena) const;
+
+    /**
+     * @brief Obtiene el texto asociado a un código.
+     * @param codigo Código previamente devuelto por codificar().
+     * @return Referencia constante y estable al texto.
+     * @throws std::out_of_range si el código no existe.
+     * @details Sin candado: una carga atómica por llamada.
+     */
+    const std::string& decodificar(std::uint16_t codigo) const;
+
+    /**
+     * @brief Cantidad de textos distintos registrados (incluye la cadena vacía).
+     */
+    size_t tamano() const;
+
+    /**
+     * @brief Diccionario global compartido por todas las carreras de Estudiante.
+     * @return Referencia a la instancia única.
+     */
+    static DiccionarioCadenas& carreras();
+};
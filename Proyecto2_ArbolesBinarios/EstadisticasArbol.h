@@ -0,0 +1,51 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief Contadores acumulados para una categoría de operación del árbol.
+ * @details
+ * - llamadas: veces que se invocó la operación pública.
+ * - comparaciones: comparaciones de claves realizadas.
+ * - visitas: nodos tocados durante la operación.
+ * - asignaciones: nodos nuevos reservados con new.
+ */
+struct ContadoresOperacion {
+    std::uint64_t llamadas = 0;
+    std::uint64_t comparaciones = 0;
+    std::uint64_t visitas = 0;
+    std::uint64_t asignaciones = 0;
+};
+
+/**
+ * @brief Instrumentación opcional de ArbolBinarioBusqueda.
+ * @details
+ * Solo se actualiza cuando el proyecto se compila con la macro ABB_ESTADISTICAS
+ * (habilitada en las configuraciones Debug). Sin la macro, el código de conteo
+ * se elimina en compilación y todos los valores permanecen en cero.
+ *
+ * El histograma de profundidad registra, para cada búsqueda por promedio,
+ * cuántos nodos se visitaron. Un árbol sano concentra las búsquedas cerca de
+ * log2(n); una cola larga indica que el árbol se está degenerando.
+ */
+struct EstadisticasArbol {
+    /**
+     * @brief Cantidad de cubetas del histograma; la última acumula las profundidades mayores.
+     */
+    static const int CUBETAS_PROFUNDIDAD = 64;
+
+    /**
+     * @brief Indica si la instrumentación fue compilada (ABB_ESTADISTICAS).
+     */
+    bool habilitadas = false;
+
+    ContadoresOperacion insercion;          ///< insertar
+    ContadoresOperacion busqueda_promedio;  ///< buscar_por_promedio
+    ContadoresOperacion busqueda_id;        ///< buscar_por_id
+    ContadoresOperacion recorrido;          ///< recorridos DFS y BFS
+
+    /**
+     * @brief Histograma de profundidad de las búsquedas por promedio.
+     */
+    std::array<std::uint64_t, CUBETAS_PROFUNDIDAD> histograma_profundidad{};
+};
@@ -1,6 +1,6 @@
 #include "Estudiante.h"
-#include <sstream>
-#include <iomanip>
+#include "DiccionarioCadenas.h"
+#include <charconv>
 #include <cmath>
 
 using namespace std;
@@ -9,24 +9,27 @@ using namespace std;
  * @brief Constructor por defecto de Estudiante.
  * @details
  * Inicializa el id del estudiante en 0 y el promedio en 0.0.
- * El nombre y la carrera se dejan con sus valores por defecto
- * de std::string (cadenas vacas).
+ * El nombre queda vacío y la carrera usa el código 0, que el
+ * diccionario de carreras reserva para la cadena vacía.
  */
-Estudiante::Estudiante() : id_(0), promedio_(0.0) {}
+Estudiante::Estudiante() : id_(0), codigo_carrera_(0), promedio_(0.0) {}
 
 /**
  * @brief Constructor que inicializa todos los atributos del estudiante.
- * @param id Identificador nico del estudiante.
+ * @param id Identificador único del estudiante.
  * @param nombre Nombre completo del estudiante.
- * @param carrera Carrera o programa acadmico del estudiante.
- * @param promedio Promedio acadmico en escala 0.0 - 100.0.
+ * @param carrera Carrera o programa académico del estudiante.
+ * @param promedio Promedio académico en escala 0.0 - 100.0.
+ * @details
+ * El nombre se mueve al atributo. La carrera se interna en el diccionario
+ * compartido y se guarda su código.
  */
-Estudiante::Estudiante(int id, const string& nombre, const string& carrera, double promedio)
-    : id_(id), nombre_(nombre), carrera_(carrera), promedio_(promedio) {
+Estudiante::Estudiante(int id, string nombre, string_view carrera, double promedio)
+    : id_(id), codigo_carrera_(DiccionarioCadenas::carreras().codificar(carrera)), nombre_(std::move(nombre)), promedio_(promedio) {
 }
 
 /**
- * @brief Obtiene el identificador nico del estudiante.
+ * @brief Obtiene el identificador único del estudiante.
  * @return Entero con el id del estudiante.
  */
 int Estudiante::id() const { return id_; }
@@ -41,16 +44,22 @@ const string& Estudiante::nombre() const { return nombre_; }
  * @brief Obtiene la carrera del estudiante.
  * @return Referencia constante a la cadena con la carrera del estudiante.
  */
-const string& Estudiante::carrera() const { return carrera_; }
+const string& Estudiante::carrera() const { return DiccionarioCadenas::carreras().decodificar(codigo_carrera_); }
+
+/**
+ * @brief Obtiene el código interno de la carrera.
+ * @return Código de la carrera en el diccionario compartido.
+ */
+uint16_t Estudiante::codigo_carrera() const { return codigo_carrera_; }
 
 /**
- * @brief Obtiene el promedio acadmico del estudiante.
+ * @brief Obtiene el promedio académico del estudiante.
  * @return Valor en punto flotante entre 0.0 y 100.0.
  */
 double Estudiante::promedio() const { return promedio_; }
 
 /**
- * @brief Establece el identificador nico del estudiante.
+ * @brief Establece el identificador único del estudiante.
  * @param id Nuevo identificador para el estudiante.
  */
 void Estudiante::set_id(int id) { id_ = id; }
@@ -59,46 +68,70 @@ void Estudiante::set_id(int id) { id_ = id; }
  * @brief Establece el nombre del estudiante.
  * @param nombre Nueva cadena con el nombre del estudiante.
  */
-void Estudiante::set_nombre(const string& nombre) { nombre_ = nombre; }
+void Estudiante::set_nombre(string nombre) { nombre_ = std::move(nombre); }
 
 /**
  * @brief Establece la carrera del estudiante.
- * @param carrera Nueva cadena con la carrera o programa acadmico del estudiante.
+ * @param carrera Nueva cadena con la carrera o programa académico del estudiante.
  */
-void Estudiante::set_carrera(const string& carrera) { carrera_ = carrera; }
+void Estudiante::set_carrera(string_view carrera) { codigo_carrera_ = DiccionarioCadenas::carreras().codificar(carrera); }
 
 /**
- * @brief Establece el promedio acadmico del estudiante.
+ * @brief Establece el promedio académico del estudiante.
  * @param promedio Nuevo promedio en escala 0.0 - 100.0.
- * @note Se asume que el valor est dentro del rango vlido 0.0 - 100.0.
+ * @note Se asume que el valor está dentro del rango válido 0.0 - 100.0.
  */
 void Estudiante::set_promedio(double promedio) { promedio_ = promedio; }
 
 /**
- * @brief Genera una representacin en texto del estudiante.
+ * @brief Genera una representación en texto del estudiante.
  * @details
  * Construye una cadena que incluye el id, el nombre, la carrera
- * y el promedio formateado a dos decimales. Es til para mostrar
- * informacin en consola o para depuracin.
+ * y el promedio formateado a dos decimales. Es útil para mostrar
+ * información en consola o para depuración.
  *
  * Ejemplo de salida:
  * @code
- * ID=1 | Juan Prez (Ingeniera) | Promedio=89.50
+ * ID=1 | Juan Pérez (Ingeniería) | Promedio=89.50
  * @endcode
  *
- * @return Cadena con la informacin formateada del estudiante.
+ * @return Cadena con la información formateada del estudiante.
  */
 string Estudiante::a_texto() const {
-    ostringstream salida;
-    salida << "ID=" << id_ << " | " << nombre_ << " (" << carrera_ << ") | Promedio="
-        << fixed << setprecision(2) << promedio_;
-    return salida.str();
+    string salida;
+    anexar_texto(salida);
+    return salida;
+}
+
+/**
+ * @brief Escribe el texto del estudiante al final del búfer indicado.
+ * @param buffer Búfer reutilizable del llamador.
+ * @details
+ * El id y el promedio (punto fijo, dos decimales) se convierten con
+ * std::to_chars, que no depende de la configuración regional ni reserva
+ * memoria. El resultado es idéntico al formato de a_texto().
+ */
+void Estudiante::anexar_texto(string& buffer) const {
+    char numero[32];
+
+    buffer.append("ID=");
+    to_chars_result resultado = to_chars(numero, numero + sizeof(numero), id_);
+    buffer.append(numero, resultado.ptr);
+
+    buffer.append(" | ");
+    buffer.append(nombre_);
+    buffer.append(" (");
+    buffer.append(carrera());
+    buffer.append(") | Promedio=");
+
+    resultado = to_chars(numero, numero + sizeof(numero), promedio_, chars_format::fixed, 2);
+    buffer.append(numero, resultado.ptr);
 }
 
 /**
- * @brief Convierte el promedio a una clave entera en centsimas.
+ * @brief Convierte el promedio a una clave entera en centésimas.
  * @details
- * Multiplica el promedio por 100 y aplica un redondeo al entero ms cercano.
+ * Multiplica el promedio por 100 y aplica un redondeo al entero más cercano.
  * Esto permite representar promedios con dos decimales como un entero,
  * lo cual puede facilitar ordenamientos y manejo en estructuras de datos.
  *
@@ -106,8 +139,8 @@ string Estudiante::a_texto() const {
  * - 87.356 -> 8736
  * - 90.0   -> 9000
  *
- * @param promedio Promedio acadmico en escala 0.0 - 100.0.
- * @return Entero que representa el promedio escalado a centsimas.
+ * @param promedio Promedio académico en escala 0.0 - 100.0.
+ * @return Entero que representa el promedio escalado a centésimas.
  */
 int convertir_promedio_a_clave(double promedio) {
     return static_cast<int>(round(promedio * 100.0));
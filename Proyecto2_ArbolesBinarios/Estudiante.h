@@ -1,32 +1,41 @@
 #pragma once
+#include <cstdint>
 #include <string>
+#include <string_view>
 
 /**
- * @brief Representa a un estudiante con datos bsicos.
+ * @brief Representa a un estudiante con datos básicos.
  * @details
- * Contiene un identificador nico, nombre, carrera y el promedio
+ * Contiene un identificador único, nombre, carrera y el promedio
  * en una escala de 0.0 a 100.0. Se utiliza como entidad principal
- * para almacenar y manipular la informacin acadmica de un estudiante.
+ * para almacenar y manipular la información académica de un estudiante.
+ *
+ * La carrera se guarda como un código de 16 bits del diccionario compartido
+ * DiccionarioCadenas::carreras(), ya que solo existen unas pocas decenas de
+ * programas distintos; así cada estudiante no repite el texto de su carrera.
  */
 class Estudiante {
 private:
     /**
-     * @brief Identificador nico del estudiante.
+     * @brief Identificador único del estudiante.
      */
     int id_;
 
     /**
-     * @brief Nombre completo del estudiante.
+     * @brief Código de la carrera en DiccionarioCadenas::carreras().
+     * @details
+     * Se declara junto al id para que ambos compartan la misma palabra
+     * de 8 bytes y no se agregue relleno al objeto.
      */
-    std::string nombre_;
+    std::uint16_t codigo_carrera_;
 
     /**
-     * @brief Carrera o programa acadmico del estudiante.
+     * @brief Nombre completo del estudiante.
      */
-    std::string carrera_;
+    std::string nombre_;
 
     /**
-     * @brief Promedio acadmico del estudiante en escala 0.0 - 100.0.
+     * @brief Promedio académico del estudiante en escala 0.0 - 100.0.
      */
     double promedio_; // 0.0 - 100.0
 
@@ -35,23 +44,48 @@ public:
      * @brief Constructor por defecto.
      * @details
      * Inicializa un estudiante con valores neutros/por defecto.
-     * La implementacin concreta se define en el archivo .cpp.
+     * La implementación concreta se define en el archivo .cpp.
      */
     Estudiante();
 
     /**
      * @brief Constructor que inicializa todos los atributos del estudiante.
-     * @param id Identificador nico del estudiante.
-     * @param nombre Nombre completo del estudiante.
-     * @param carrera Carrera o programa acadmico del estudiante.
-     * @param promedio Promedio acadmico en escala 0.0 - 100.0.
+     * @param id Identificador único del estudiante.
+     * @param nombre Nombre completo del estudiante; se recibe por valor y se
+     *               mueve al atributo, así un temporal no se copia.
+     * @param carrera Carrera o programa académico del estudiante; solo se
+     *                lee para internarla, por eso basta una vista.
+     * @param promedio Promedio académico en escala 0.0 - 100.0.
+     */
+    Estudiante(int id, std::string nombre, std::string_view carrera, double promedio);
+
+    /**
+     * @brief Constructor de copia.
+     */
+    Estudiante(const Estudiante&) = default;
+
+    /**
+     * @brief Constructor de movimiento; no lanza excepciones.
+     * @details
+     * Al ser noexcept, los contenedores como std::vector mueven (en lugar de
+     * copiar) los estudiantes al crecer.
+     */
+    Estudiante(Estudiante&&) noexcept = default;
+
+    /**
+     * @brief Asignación por copia.
      */
-    Estudiante(int id, const std::string& nombre, const std::string& carrera, double promedio);
+    Estudiante& operator=(const Estudiante&) = default;
+
+    /**
+     * @brief Asignación por movimiento; no lanza excepciones.
+     */
+    Estudiante& operator=(Estudiante&&) noexcept = default;
 
     // Getters
 
     /**
-     * @brief Obtiene el identificador nico del estudiante.
+     * @brief Obtiene el identificador único del estudiante.
      * @return Entero que representa el id del estudiante.
      */
     int id() const;
@@ -64,12 +98,21 @@ public:
 
     /**
      * @brief Obtiene la carrera del estudiante.
-     * @return Referencia constante a la cadena con la carrera.
+     * @return Referencia constante a la cadena con la carrera, almacenada en
+     *         el diccionario compartido de carreras.
      */
     const std::string& carrera() const;
 
     /**
-     * @brief Obtiene el promedio acadmico del estudiante.
+     * @brief Obtiene el código interno de la carrera.
+     * @return Código de la carrera en DiccionarioCadenas::carreras().
+     * @details
+     * Permite comparar o agrupar por carrera sin comparar cadenas.
+     */
+    std::uint16_t codigo_carrera() const;
+
+    /**
+     * @brief Obtiene el promedio académico del estudiante.
      * @return Valor en punto flotante entre 0.0 y 100.0.
      */
     double promedio() const;
@@ -77,53 +120,69 @@ public:
     // Setters
 
     /**
-     * @brief Establece el identificador nico del estudiante.
+     * @brief Establece el identificador único del estudiante.
      * @param id Nuevo identificador para el estudiante.
      */
     void set_id(int id);
 
     /**
      * @brief Establece el nombre del estudiante.
-     * @param nombre Nueva cadena con el nombre del estudiante.
+     * @param nombre Nueva cadena con el nombre del estudiante; se recibe por
+     *               valor y se mueve, por lo que un temporal no se copia.
      */
-    void set_nombre(const std::string& nombre);
+    void set_nombre(std::string nombre);
 
     /**
      * @brief Establece la carrera del estudiante.
-     * @param carrera Nueva cadena con la carrera o programa acadmico.
+     * @param carrera Nueva cadena con la carrera o programa académico.
+     * @details
+     * La cadena se interna en el diccionario de carreras y solo se guarda su
+     * código; como nunca se almacena, basta con recibir una vista.
      */
-    void set_carrera(const std::string& carrera);
+    void set_carrera(std::string_view carrera);
 
     /**
-     * @brief Establece el promedio acadmico del estudiante.
+     * @brief Establece el promedio académico del estudiante.
      * @param promedio Nuevo promedio en escala 0.0 - 100.0.
      * @note Es responsabilidad de quien llama garantizar que el valor
-     *       est dentro del rango vlido.
+     *       esté dentro del rango válido.
      */
     void set_promedio(double promedio);
 
     /**
-     * @brief Genera una representacin en texto del estudiante.
+     * @brief Genera una representación en texto del estudiante.
      * @details
-     * Suele utilizarse para mostrar la informacin en consola o para
-     * depuracin, formateando los campos del estudiante en una cadena.
-     * @return Cadena con la informacin relevante del estudiante.
+     * Suele utilizarse para mostrar la información en consola o para
+     * depuración, formateando los campos del estudiante en una cadena.
+     * @return Cadena con la información relevante del estudiante.
      */
     std::string a_texto() const;
+
+    /**
+     * @brief Agrega la representación en texto del estudiante al final de un búfer.
+     * @param buffer Cadena del llamador donde se escribe el texto.
+     * @details
+     * Produce exactamente el mismo formato que a_texto(), pero sin crear
+     * flujos ni cadenas temporales: los números se convierten con
+     * std::to_chars en una pila local. Si el llamador reutiliza el mismo
+     * búfer (vaciándolo con clear(), que conserva la capacidad), listar
+     * millones de estudiantes no realiza reservas de memoria adicionales.
+     */
+    void anexar_texto(std::string& buffer) const;
 };
 
 /**
- * @brief Convierte un promedio en una clave entera en centsimas.
+ * @brief Convierte un promedio en una clave entera en centésimas.
  * @details
  * Toma un valor de promedio en punto flotante (0.0 - 100.0) y lo escala
- * a un entero en centsimas para facilitar operaciones como ordenamiento
+ * a un entero en centésimas para facilitar operaciones como ordenamiento
  * o uso como clave en estructuras de datos.
  *
  * Ejemplo:
  * - 87.356 -> 8736 (aprox.)
  *
- * @param promedio Promedio acadmico en escala 0.0 - 100.0.
- * @return Entero que representa el promedio escalado a centsimas.
+ * @param promedio Promedio académico en escala 0.0 - 100.0.
+ * @return Entero que representa el promedio escalado a centésimas.
  */
 int convertir_promedio_a_clave(double promedio);
 
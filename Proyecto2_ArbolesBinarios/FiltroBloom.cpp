@@ -0,0 +1,97 @@
+#include "FiltroBloom.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using namespace std;
+
+/**
+ * @brief Calcula bloques y cantidad de hashes.
+ * @param cantidad_esperada Claves esperadas.
+ * @param tasa_falsos_positivos Tasa buscada.
+ * @details
+ * Con m bits y n claves, la cantidad óptima de hashes es (m / n) ln 2, que
+ * con el m clásico se reduce a -log2(p): 7 para el 1 %.
+ */
+FiltroBloom::FiltroBloom(size_t cantidad_esperada, double tasa_falsos_positivos) {
+    if (!(tasa_falsos_positivos > 0.0 && tasa_falsos_positivos < 1.0)) {
+        throw invalid_argument("FiltroBloom: la tasa de falsos positivos debe estar entre 0 y 1");
+    }
+    const double claves = static_cast<double>(std::max<size_t>(cantidad_esperada, 1));
+    const double ln2 = log(2.0);
+    const double bits = 1.25 * -claves * log(tasa_falsos_positivos) / (ln2 * ln2);
+    bloques_ = std::max<size_t>(1, static_cast<size_t>(ceil(bits / (PALABRAS_POR_BLOQUE * 64))));
+    hashes_ = std::clamp(static_cast<int>(lround(-log(tasa_falsos_positivos) / ln2)), 1, 16);
+    palabras_.assign(bloques_ * PALABRAS_POR_BLOQUE, 0);
+}
+
+/**
+ * @brief Finalizador de SplitMix64: cada bit de entrada afecta a todos los de salida.
+ * @param valor Valor a mezclar.
+ * @return Valor mezclado.
+ */
+uint64_t FiltroBloom::mezclar(uint64_t valor) {
+    valor += 0x9E3779B97F4A7C15ULL;
+    valor = (valor ^ (valor >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    valor = (valor ^ (valor >> 27)) * 0x94D049BB133111EBULL;
+    return valor ^ (valor >> 31);
+}
+
+/**
+ * @brief Recorre los bits de una clave dentro de su bloque.
+ * @param clave Clave.
+ * @param funcion Recibe (índice de palabra, máscara); devuelve false para detenerse.
+ * @return false si la función se detuvo.
+ */
+template <typename Funcion>
+bool FiltroBloom::para_cada_bit(uint64_t clave, Funcion funcion) const {
+    const uint64_t primero = mezclar(clave);
+    const size_t bloque = static_cast<size_t>(((primero >> 32) * static_cast<uint64_t>(bloques_)) >> 32);
+    const size_t base = bloque * PALABRAS_POR_BLOQUE;
+    uint64_t segundo = mezclar(primero);
+    for (int indice = 0; indice < hashes_; ++indice) {
+        if (indice > 0 && indice % 7 == 0) segundo = mezclar(segundo);
+        const unsigned trozo = static_cast<unsigned>(segundo >> (9 * (indice % 7))) & 511u;
+        if (!funcion(base + (trozo >> 6), 1ULL << (trozo & 63u))) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Enciende los bits de la clave.
+ * @param clave Clave a agregar.
+ */
+void FiltroBloom::agregar(uint64_t clave) {
+    para_cada_bit(clave, [this](size_t palabra, uint64_t mascara) {
+        palabras_[palabra] |= mascara;
+        return true;
+        });
+}
+
+/**
+ * @brief Comprueba los bits de la clave; se detiene en el primero apagado.
+ * @param clave Clave a consultar.
+ * @return true si todos están encendidos.
+ */
+bool FiltroBloom::puede_contener(uint64_t clave) const {
+    return para_cada_bit(clave, [this](size_t palabra, uint64_t mascara) {
+        return (palabras_[palabra] & mascara) != 0;
+        });
+}
+
+/**
+ * @brief Apaga todos los bits.
+ */
+void FiltroBloom::limpiar() { fill(palabras_.begin(), palabras_.end(), 0); }
+
+/**
+ * @brief Tamaño en bits.
+ * @return Bloques por 512.
+ */
+size_t FiltroBloom::cantidad_bits() const { return palabras_.size() * 64; }
+
+/**
+ * @brief Bits por clave.
+ * @return Cantidad de hashes.
+ */
+int FiltroBloom::cantidad_hashes() const { return hashes_; }
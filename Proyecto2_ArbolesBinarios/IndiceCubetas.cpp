@@ -0,0 +1,333 @@
+#include "IndiceCubetas.h"
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+
+/**
+ * @brief Palabras del mapa de bits de cubetas ocupadas.
+ */
+static const int PALABRAS_OCUPADAS = (IndiceCubetas::CANTIDAD_CUBETAS + 63) / 64;
+
+/**
+ * @brief Crea las 10001 cubetas vacías, el mapa de bits y el árbol de Fenwick.
+ */
+IndiceCubetas::IndiceCubetas()
+    : cubetas_(CANTIDAD_CUBETAS), ocupadas_(PALABRAS_OCUPADAS, 0), acumulados_(CANTIDAD_CUBETAS + 1), cantidad_(0) {
+}
+
+// ---------- Auxiliares ----------
+
+/**
+ * @brief Primera cubeta ocupada a partir de desde.
+ * @details
+ * Descarta los bits anteriores de la primera palabra y luego salta
+ * palabras completas en cero; dentro de una palabra usa countr_zero.
+ */
+int IndiceCubetas::siguiente_ocupada(int desde) const {
+    if (desde < 0) desde = 0;
+    if (desde >= CANTIDAD_CUBETAS) return CANTIDAD_CUBETAS;
+    int palabra = desde / 64;
+    uint64_t bits = ocupadas_[palabra] & (~0ULL << (desde % 64));
+    while (bits == 0) {
+        if (++palabra == PALABRAS_OCUPADAS) return CANTIDAD_CUBETAS;
+        bits = ocupadas_[palabra];
+    }
+    return palabra * 64 + countr_zero(bits);
+}
+
+/**
+ * @brief Última cubeta ocupada hasta desde, recorriendo las palabras hacia atrás.
+ */
+int IndiceCubetas::anterior_ocupada(int desde) const {
+    if (desde >= CANTIDAD_CUBETAS) desde = CANTIDAD_CUBETAS - 1;
+    if (desde < 0) return -1;
+    int palabra = desde / 64;
+    uint64_t bits = ocupadas_[palabra] & (~0ULL >> (63 - desde % 64));
+    while (bits == 0) {
+        if (--palabra < 0) return -1;
+        bits = ocupadas_[palabra];
+    }
+    return palabra * 64 + 63 - countl_zero(bits);
+}
+
+/**
+ * @brief Agrega un estudiante a los nodos del árbol de Fenwick que cubren su cubeta.
+ * @param clave_promedio_cent Clave (y cubeta) del estudiante.
+ */
+void IndiceCubetas::sumar_acumulado(int clave_promedio_cent) {
+    const long long clave = clave_promedio_cent;
+    for (int indice = clave_promedio_cent + 1; indice <= CANTIDAD_CUBETAS; indice += indice & -indice) {
+        Acumulado& acumulado = acumulados_[indice];
+        ++acumulado.cantidad;
+        acumulado.suma += clave;
+        acumulado.suma_cuadrados += clave * clave;
+    }
+}
+
+/**
+ * @brief Suma los nodos del árbol de Fenwick que cubren las cubetas 0 .. cubeta - 1.
+ * @param cubeta Límite exclusivo.
+ * @return Totales del prefijo.
+ */
+IndiceCubetas::Acumulado IndiceCubetas::prefijo(int cubeta) const {
+    Acumulado total;
+    for (int indice = std::clamp(cubeta, 0, CANTIDAD_CUBETAS); indice > 0; indice -= indice & -indice) {
+        total.cantidad += acumulados_[indice].cantidad;
+        total.suma += acumulados_[indice].suma;
+        total.suma_cuadrados += acumulados_[indice].suma_cuadrados;
+    }
+    return total;
+}
+
+/**
+ * @brief Recorre las cubetas ocupadas desde una clave hasta que visitar devuelva false.
+ * @param clave_promedio_cent Clave de inicio.
+ * @param id ID de inicio dentro de la primera cubeta.
+ * @param estricta true para saltar la clave exacta.
+ * @param visitar Función que recibe cada estudiante.
+ */
+void IndiceCubetas::recorrer_desde(int clave_promedio_cent, int id, bool estricta, const function<bool(const Estudiante&)>& visitar) const {
+    if (clave_promedio_cent > CANTIDAD_CUBETAS - 1) return;
+    const bool desde_el_principio = clave_promedio_cent < 0;
+    if (desde_el_principio) clave_promedio_cent = 0;
+
+    for (int cubeta = siguiente_ocupada(clave_promedio_cent); cubeta < CANTIDAD_CUBETAS; cubeta = siguiente_ocupada(cubeta + 1)) {
+        const Cubeta& estudiantes = cubetas_[cubeta];
+        auto actual = estudiantes.begin();
+        if (cubeta == clave_promedio_cent && !desde_el_principio) {
+            actual = estricta ? estudiantes.upper_bound(id) : estudiantes.lower_bound(id);
+        }
+        for (; actual != estudiantes.end(); ++actual) {
+            if (!visitar(actual->second)) return;
+        }
+    }
+}
+
+// ---------- Inserción ----------
+
+/**
+ * @brief Inserta una copia del estudiante.
+ * @param estudiante Estudiante a insertar.
+ */
+void IndiceCubetas::insertar(const Estudiante& estudiante) {
+    insertar(Estudiante(estudiante));
+}
+
+/**
+ * @brief Ubica al estudiante en la cubeta de su promedio, bajo su ID.
+ * @param estudiante Estudiante a mover.
+ * @details
+ * Si ya hay un estudiante con el mismo promedio e ID se reemplaza en su
+ * lugar y los totales no cambian; si no, se inserta en O(log b) y se
+ * actualizan el mapa de bits y el árbol de Fenwick.
+ */
+void IndiceCubetas::insertar(Estudiante&& estudiante) {
+    const int clave = convertir_promedio_a_clave(estudiante.promedio());
+    if (clave < 0 || clave >= CANTIDAD_CUBETAS) {
+        throw out_of_range("IndiceCubetas: el promedio debe estar entre 0.0 y 100.0");
+    }
+
+    const int id = estudiante.id();
+    if (!cubetas_[clave].insert_or_assign(id, std::move(estudiante)).second) return;
+    ocupadas_[clave / 64] |= 1ULL << (clave % 64);
+    sumar_acumulado(clave);
+    ++cantidad_;
+}
+
+/**
+ * @brief Construye el estudiante y lo mueve a su cubeta.
+ */
+void IndiceCubetas::emplazar(int id, string nombre, string_view carrera, double promedio) {
+    insertar(Estudiante(id, std::move(nombre), carrera, promedio));
+}
+
+// ---------- Búsquedas ----------
+
+/**
+ * @brief Primer estudiante de la cubeta del promedio.
+ * @param promedio Promedio buscado.
+ * @return El de menor ID, o nullptr si la cubeta está vacía o el promedio está fuera del dominio.
+ */
+const Estudiante* IndiceCubetas::buscar_por_promedio(double promedio) const {
+    const int clave = convertir_promedio_a_clave(promedio);
+    if (clave < 0 || clave >= CANTIDAD_CUBETAS || cubetas_[clave].empty()) return nullptr;
+    return &cubetas_[clave].begin()->second;
+}
+
+/**
+ * @brief Busca un ID recorriendo todas las cubetas ocupadas.
+ * @param id ID buscado.
+ * @return El primero en orden (promedio, ID) con ese ID, o nullptr.
+ */
+const Estudiante* IndiceCubetas::buscar_por_id(int id) const {
+    const Estudiante* encontrado = nullptr;
+    recorrer_desde(INT_MIN, INT_MIN, false, [&](const Estudiante& estudiante) {
+        if (estudiante.id() != id) return true;
+        encontrado = &estudiante;
+        return false;
+        });
+    return encontrado;
+}
+
+/**
+ * @brief Resuelve cada promedio del lote con buscar_por_promedio.
+ * @param promedios Promedios a buscar.
+ * @return Resultados en el mismo orden.
+ */
+vector<const Estudiante*> IndiceCubetas::buscar_lote(span<const double> promedios) const {
+    vector<const Estudiante*> resultados(promedios.size());
+    for (size_t indice = 0; indice < promedios.size(); ++indice) {
+        resultados[indice] = buscar_por_promedio(promedios[indice]);
+    }
+    return resultados;
+}
+
+/**
+ * @brief Resuelve un lote de IDs con un solo recorrido.
+ * @param ids IDs a buscar.
+ * @return Resultados en el mismo orden.
+ * @details
+ * Ordena las sondas por ID y, por cada estudiante recorrido, busca su ID
+ * entre ellas; un ID repetido en el lote se resuelve en todas sus posiciones
+ * a la vez.
+ */
+vector<const Estudiante*> IndiceCubetas::buscar_lote_por_id(span<const int> ids) const {
+    vector<const Estudiante*> resultados(ids.size(), nullptr);
+    vector<pair<int, size_t>> sondas(ids.size());
+    for (size_t indice = 0; indice < ids.size(); ++indice) sondas[indice] = { ids[indice], indice };
+    sort(sondas.begin(), sondas.end());
+
+    size_t pendientes = sondas.size();
+    if (pendientes == 0) return resultados;
+    recorrer_desde(INT_MIN, INT_MIN, false, [&](const Estudiante& estudiante) {
+        auto sonda = lower_bound(sondas.begin(), sondas.end(), pair<int, size_t>(estudiante.id(), 0));
+        if (sonda == sondas.end() || sonda->first != estudiante.id() || resultados[sonda->second] != nullptr) return true;
+        for (; sonda != sondas.end() && sonda->first == estudiante.id(); ++sonda) {
+            resultados[sonda->second] = &estudiante;
+            --pendientes;
+        }
+        return pendientes > 0;
+        });
+    return resultados;
+}
+
+// ---------- Rangos y recorridos ----------
+
+/**
+ * @brief Visita las cubetas ocupadas entre las claves de minimo y maximo.
+ * @param minimo Promedio mínimo.
+ * @param maximo Promedio máximo.
+ * @param visitar Función callback para cada estudiante.
+ */
+void IndiceCubetas::rango(double minimo, double maximo, const function<void(const Estudiante&)>& visitar) const {
+    const int clave_minima = std::max(convertir_promedio_a_clave(minimo), 0);
+    const int clave_maxima = std::min(convertir_promedio_a_clave(maximo), CANTIDAD_CUBETAS - 1);
+    for (int cubeta = siguiente_ocupada(clave_minima); cubeta <= clave_maxima; cubeta = siguiente_ocupada(cubeta + 1)) {
+        for (const auto& [id, estudiante] : cubetas_[cubeta]) visitar(estudiante);
+    }
+}
+
+/**
+ * @brief Estadísticas de un rango como diferencia de dos prefijos.
+ * @param minimo Promedio mínimo.
+ * @param maximo Promedio máximo.
+ * @return Cantidad, media y varianza (misma escala que ArbolBinarioBusqueda).
+ */
+EstadisticasRango IndiceCubetas::estadisticas_rango(double minimo, double maximo) const {
+    EstadisticasRango resultado;
+    const int clave_minima = convertir_promedio_a_clave(minimo);
+    const int clave_maxima = convertir_promedio_a_clave(maximo);
+    if (clave_minima > clave_maxima) return resultado;
+
+    const Acumulado hasta = prefijo(clave_maxima + 1);
+    const Acumulado antes = prefijo(clave_minima);
+    const long long cantidad = hasta.cantidad - antes.cantidad;
+    if (cantidad <= 0) return resultado;
+    const double media_cent = static_cast<double>(hasta.suma - antes.suma) / cantidad;
+    const double varianza_cent = static_cast<double>(hasta.suma_cuadrados - antes.suma_cuadrados) / cantidad - media_cent * media_cent;
+
+    resultado.cantidad = static_cast<int>(cantidad);
+    resultado.media = media_cent / 100.0;
+    resultado.varianza = std::max(0.0, varianza_cent) / 10000.0;
+    return resultado;
+}
+
+/**
+ * @brief Recorre las cubetas ocupadas de menor a mayor.
+ * @param visitar Función callback para cada estudiante.
+ */
+void IndiceCubetas::inorden(const function<void(const Estudiante&)>& visitar) const {
+    for (int cubeta = siguiente_ocupada(0); cubeta < CANTIDAD_CUBETAS; cubeta = siguiente_ocupada(cubeta + 1)) {
+        for (const auto& [id, estudiante] : cubetas_[cubeta]) visitar(estudiante);
+    }
+}
+
+/**
+ * @brief Recorre las cubetas ocupadas de mayor a menor, cada una desde el último ID.
+ * @param k Cantidad máxima de estudiantes.
+ * @param visitar Función callback para cada estudiante.
+ */
+void IndiceCubetas::top_k(int k, const function<void(const Estudiante&)>& visitar) const {
+    if (k <= 0) return;
+    for (int cubeta = anterior_ocupada(CANTIDAD_CUBETAS - 1); cubeta >= 0; cubeta = anterior_ocupada(cubeta - 1)) {
+        const Cubeta& estudiantes = cubetas_[cubeta];
+        for (auto estudiante = estudiantes.rbegin(); estudiante != estudiantes.rend(); ++estudiante) {
+            visitar(estudiante->second);
+            if (--k == 0) return;
+        }
+    }
+}
+
+/**
+ * @brief Visita los primeros k estudiantes en orden ascendente.
+ * @param k Cantidad máxima de estudiantes.
+ * @param visitar Función callback para cada estudiante.
+ */
+void IndiceCubetas::bottom_k(int k, const function<void(const Estudiante&)>& visitar) const {
+    if (k <= 0) return;
+    recorrer_desde(INT_MIN, INT_MIN, false, [&](const Estudiante& estudiante) {
+        visitar(estudiante);
+        return --k > 0;
+        });
+}
+
+/**
+ * @brief Visita hasta n estudiantes desde la cubeta del cursor.
+ * @param cursor Cursor de la página anterior.
+ * @param n Tamaño de la página.
+ * @param visitar Función callback para cada estudiante.
+ * @return Cursor para la página siguiente.
+ */
+CursorPagina IndiceCubetas::siguiente_pagina(const CursorPagina& cursor, int n, const function<void(const Estudiante&)>& visitar) const {
+    CursorPagina siguiente = cursor;
+    if (n <= 0) return siguiente;
+    int visitados = 0;
+    auto visitar_estudiante = [&](const Estudiante& estudiante) {
+        visitar(estudiante);
+        siguiente.al_inicio = false;
+        siguiente.clave_promedio_cent = convertir_promedio_a_clave(estudiante.promedio());
+        siguiente.id = estudiante.id();
+        return ++visitados < n;
+        };
+    if (cursor.al_inicio) recorrer_desde(INT_MIN, INT_MIN, false, visitar_estudiante);
+    else recorrer_desde(cursor.clave_promedio_cent, cursor.id, true, visitar_estudiante);
+    return siguiente;
+}
+
+// ---------- Estado ----------
+
+/**
+ * @brief Cantidad de estudiantes.
+ * @return Total en todas las cubetas.
+ */
+int IndiceCubetas::contar_nodos() const { return cantidad_; }
+
+/**
+ * @brief Indica si no hay estudiantes.
+ * @return true si todas las cubetas están vacías.
+ */
+bool IndiceCubetas::vacio() const { return cantidad_ == 0; }
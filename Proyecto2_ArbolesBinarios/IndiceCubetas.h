@@ -0,0 +1,221 @@
+#pragma once
+#include "ArbolBinarioBusqueda.h"
+#include "Estudiante.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Índice de estudiantes con una cubeta por cada promedio posible.
+ * @details
+ * convertir_promedio_a_clave() lleva cualquier promedio válido a un entero
+ * entre 0 y 10000, así que en lugar de comparar claves se usa la clave como
+ * índice de un arreglo de 10001 cubetas. Cada cubeta guarda, en un mapa
+ * ordenado por ID, los estudiantes con ese promedio; el orden global
+ * (promedio, ID) es el mismo que el de ArbolBinarioBusqueda.
+ *
+ * - buscar_por_promedio es O(1): el menor ID es el primero de su cubeta.
+ * - insertar es O(log b), con b los estudiantes de la cubeta, así que una
+ *   carga con pocos promedios distintos no se vuelve cuadrática.
+ * - Los recorridos y rangos avanzan por cubetas vecinas y saltan las vacías
+ *   con un mapa de bits (64 cubetas por palabra).
+ * - estadisticas_rango usa un árbol de Fenwick por cubeta: O(log 10001)
+ *   sin importar cuántos estudiantes haya en el rango.
+ *
+ * Ofrece las mismas consultas que el árbol para poder usarse como motor
+ * alternativo. Como en el árbol, los punteros devueltos siguen siendo
+ * válidos mientras viva el índice (reemplazar un estudiante con la misma
+ * clave reutiliza su lugar). No tiene eliminación ni es seguro para usarse
+ * desde varios hilos a la vez.
+ */
+class IndiceCubetas {
+public:
+    /**
+     * @brief Cantidad de cubetas: una por cada clave entre 0 y 10000.
+     */
+    static constexpr int CANTIDAD_CUBETAS = 10001;
+
+private:
+    /**
+     * @brief Totales de un tramo de cubetas (nodo del árbol de Fenwick).
+     */
+    struct Acumulado {
+        long long cantidad = 0;
+        long long suma = 0;             ///< suma de claves en centésimas
+        long long suma_cuadrados = 0;   ///< suma de claves al cuadrado
+    };
+
+    /**
+     * @brief Estudiantes de una cubeta, indexados por ID.
+     */
+    using Cubeta = std::map<int, Estudiante>;
+
+    /**
+     * @brief Estudiantes de cada promedio, ordenados por ID.
+     */
+    std::vector<Cubeta> cubetas_;
+
+    /**
+     * @brief Bit i encendido si la cubeta i tiene estudiantes.
+     */
+    std::vector<std::uint64_t> ocupadas_;
+
+    /**
+     * @brief Árbol de Fenwick (base 1) sobre las cubetas.
+     */
+    std::vector<Acumulado> acumulados_;
+
+    /**
+     * @brief Cantidad total de estudiantes.
+     */
+    int cantidad_;
+
+    /**
+     * @brief Primera cubeta ocupada mayor o igual que la dada.
+     * @param desde Cubeta inicial (puede ser CANTIDAD_CUBETAS).
+     * @return Índice de la cubeta, o CANTIDAD_CUBETAS si no hay.
+     */
+    int siguiente_ocupada(int desde) const;
+
+    /**
+     * @brief Última cubeta ocupada menor o igual que la dada.
+     * @param desde Cubeta inicial (puede ser -1).
+     * @return Índice de la cubeta, o -1 si no hay.
+     */
+    int anterior_ocupada(int desde) const;
+
+    /**
+     * @brief Suma un estudiante con la clave dada al árbol de Fenwick.
+     */
+    void sumar_acumulado(int clave_promedio_cent);
+
+    /**
+     * @brief Totales de las cubetas 0 .. cubeta - 1.
+     * @param cubeta Límite exclusivo (0 - CANTIDAD_CUBETAS).
+     */
+    Acumulado prefijo(int cubeta) const;
+
+    /**
+     * @brief Recorre los estudiantes en orden ascendente desde la clave indicada.
+     * @param clave_promedio_cent Clave de inicio (se acota a 0 - 10000).
+     * @param id ID de inicio.
+     * @param estricta true para empezar en la primera clave estrictamente mayor.
+     * @param visitar Recibe cada estudiante; devuelve false para detenerse.
+     */
+    void recorrer_desde(int clave_promedio_cent, int id, bool estricta, const std::function<bool(const Estudiante&)>& visitar) const;
+
+public:
+    /**
+     * @brief Crea el índice vacío con sus 10001 cubetas.
+     */
+    IndiceCubetas();
+
+    /**
+     * @brief Inserta un estudiante; si su clave (promedio, ID) ya existe, lo reemplaza.
+     * @param estudiante Estudiante a insertar (se copia).
+     * @throws std::out_of_range si el promedio no está entre 0.0 y 100.0.
+     */
+    void insertar(const Estudiante& estudiante);
+
+    /**
+     * @brief Inserta un estudiante moviéndolo a su cubeta.
+     * @param estudiante Estudiante a mover.
+     * @throws std::out_of_range si el promedio no está entre 0.0 y 100.0.
+     */
+    void insertar(Estudiante&& estudiante);
+
+    /**
+     * @brief Construye un estudiante con los datos dados y lo inserta.
+     * @param id Identificador único del estudiante.
+     * @param nombre Nombre; se mueve hasta la cubeta.
+     * @param carrera Carrera o programa académico.
+     * @param promedio Promedio académico en escala 0.0 - 100.0.
+     */
+    void emplazar(int id, std::string nombre, std::string_view carrera, double promedio);
+
+    /**
+     * @brief Busca un estudiante por su promedio.
+     * @param promedio Promedio académico en escala 0.0 - 100.0.
+     * @return El de menor ID con ese promedio, o nullptr si no hay.
+     */
+    const Estudiante* buscar_por_promedio(double promedio) const;
+
+    /**
+     * @brief Busca un estudiante por su ID.
+     * @param id Identificador del estudiante.
+     * @return Puntero al estudiante o nullptr.
+     * @warning Las cubetas no están ordenadas por ID: recorre todo, O(n).
+     */
+    const Estudiante* buscar_por_id(int id) const;
+
+    /**
+     * @brief Busca varios promedios a la vez.
+     * @param promedios Promedios a buscar, en cualquier orden.
+     * @return Vector del mismo tamaño con el estudiante de cada promedio o nullptr.
+     * @details
+     * Cada sonda ya es un acceso directo, así que no hace falta ordenarlas.
+     */
+    std::vector<const Estudiante*> buscar_lote(std::span<const double> promedios) const;
+
+    /**
+     * @brief Busca varios IDs con un único recorrido de las cubetas.
+     * @param ids IDs a buscar, en cualquier orden.
+     * @return Vector del mismo tamaño con el estudiante encontrado o nullptr.
+     * @details
+     * O(n + k log k); se detiene en cuanto todas las sondas están resueltas.
+     */
+    std::vector<const Estudiante*> buscar_lote_por_id(std::span<const int> ids) const;
+
+    /**
+     * @brief Visita los estudiantes con promedio dentro de [minimo, maximo], en orden.
+     * @param minimo Promedio mínimo (incluido).
+     * @param maximo Promedio máximo (incluido).
+     * @param visitar Función callback para cada estudiante.
+     */
+    void rango(double minimo, double maximo, const std::function<void(const Estudiante&)>& visitar) const;
+
+    /**
+     * @brief Cantidad, media y varianza de los promedios dentro de [minimo, maximo].
+     * @details
+     * Resta dos prefijos del árbol de Fenwick: O(log 10001).
+     */
+    EstadisticasRango estadisticas_rango(double minimo, double maximo) const;
+
+    /**
+     * @brief Recorre todos los estudiantes en orden ascendente de (promedio, ID).
+     * @param visitar Función callback para cada estudiante.
+     */
+    void inorden(const std::function<void(const Estudiante&)>& visitar) const;
+
+    /**
+     * @brief Visita los k estudiantes con mayor promedio, de mayor a menor.
+     * @details
+     * Los empates se ordenan por ID descendente, como en el árbol.
+     */
+    void top_k(int k, const std::function<void(const Estudiante&)>& visitar) const;
+
+    /**
+     * @brief Visita los k estudiantes con menor promedio, de menor a mayor.
+     */
+    void bottom_k(int k, const std::function<void(const Estudiante&)>& visitar) const;
+
+    /**
+     * @brief Visita la página de hasta n estudiantes que sigue al cursor.
+     * @return Cursor para la página siguiente (mismo formato que ArbolBinarioBusqueda).
+     */
+    CursorPagina siguiente_pagina(const CursorPagina& cursor, int n, const std::function<void(const Estudiante&)>& visitar) const;
+
+    /**
+     * @brief Cantidad de estudiantes.
+     */
+    int contar_nodos() const;
+
+    /**
+     * @brief Indica si el índice está vacío.
+     */
+    bool vacio() const;
+};
@@ -0,0 +1,198 @@
+#include "IndiceNombres.h"
+#include <algorithm>
+
+using namespace std;
+
+/**
+ * @brief Crea el índice con solo la raíz.
+ */
+IndiceNombres::IndiceNombres() : cantidad_(0) {}
+
+// ---------- Auxiliares ----------
+
+/**
+ * @brief Pliega mayúsculas a minúsculas byte por byte.
+ * @param nombre Texto original.
+ * @return Texto plegado.
+ * @details
+ * En Latin-1 las mayúsculas acentuadas (0xC0 - 0xDE) están 0x20 posiciones
+ * antes de su minúscula, igual que en ASCII; 0xD7 (×) no es una letra.
+ */
+string IndiceNombres::plegar(string_view nombre) {
+    string plegado(nombre);
+    for (char& caracter : plegado) {
+        const unsigned char byte = static_cast<unsigned char>(caracter);
+        if ((byte >= 'A' && byte <= 'Z') || (byte >= 0xC0 && byte <= 0xDE && byte != 0xD7)) {
+            caracter = static_cast<char>(byte + 0x20);
+        }
+    }
+    return plegado;
+}
+
+/**
+ * @brief Búsqueda binaria del hijo por el primer byte de su etiqueta.
+ * @param nodo Nodo padre.
+ * @param primero Byte buscado.
+ * @return Índice del hijo o punto de inserción.
+ */
+size_t IndiceNombres::posicion_hijo(const Nodo& nodo, char primero) {
+    auto posicion = lower_bound(nodo.hijos.begin(), nodo.hijos.end(), primero, [](const unique_ptr<Nodo>& hijo, char byte) {
+        return static_cast<unsigned char>(hijo->etiqueta[0]) < static_cast<unsigned char>(byte);
+        });
+    return static_cast<size_t>(posicion - nodo.hijos.begin());
+}
+
+// ---------- Inserción / eliminación ----------
+
+/**
+ * @brief Baja consumiendo el nombre plegado y agrega al estudiante donde termina.
+ * @param estudiante Estudiante a indexar.
+ * @details
+ * Si el nombre se separa a mitad de una etiqueta, esa arista se parte en
+ * un nodo intermedio con la parte común; lo que sobra del nombre cuelga
+ * de ahí como hoja nueva.
+ */
+void IndiceNombres::insertar(const Estudiante* estudiante) {
+    const string clave = plegar(estudiante->nombre());
+    Nodo* nodo = &raiz_;
+    string_view resto = clave;
+    while (!resto.empty()) {
+        const size_t posicion = posicion_hijo(*nodo, resto[0]);
+        if (posicion == nodo->hijos.size() || nodo->hijos[posicion]->etiqueta[0] != resto[0]) {
+            auto hoja = make_unique<Nodo>();
+            hoja->etiqueta.assign(resto);
+            hoja->estudiantes.push_back(estudiante);
+            nodo->hijos.insert(nodo->hijos.begin() + posicion, std::move(hoja));
+            ++cantidad_;
+            return;
+        }
+
+        Nodo& hijo = *nodo->hijos[posicion];
+        const size_t limite = min(resto.size(), hijo.etiqueta.size());
+        size_t comun = 1;
+        while (comun < limite && hijo.etiqueta[comun] == resto[comun]) ++comun;
+        if (comun < hijo.etiqueta.size()) {
+            auto intermedio = make_unique<Nodo>();
+            intermedio->etiqueta = hijo.etiqueta.substr(0, comun);
+            hijo.etiqueta.erase(0, comun);
+            intermedio->hijos.push_back(std::move(nodo->hijos[posicion]));
+            nodo->hijos[posicion] = std::move(intermedio);
+        }
+        nodo = nodo->hijos[posicion].get();
+        resto.remove_prefix(comun);
+    }
+    nodo->estudiantes.push_back(estudiante);
+    ++cantidad_;
+}
+
+/**
+ * @brief Quita el puntero del nodo donde termina la clave y poda al volver.
+ * @param nodo Nodo actual.
+ * @param resto Clave restante.
+ * @param estudiante Puntero a quitar.
+ * @return true si se quitó.
+ * @details
+ * Un hijo que queda sin estudiantes ni hijos se elimina; uno que queda sin
+ * estudiantes y con un solo hijo se fusiona con él, para que el árbol siga
+ * comprimido. La raíz nunca se fusiona.
+ */
+bool IndiceNombres::quitar_recursivo(Nodo& nodo, string_view resto, const Estudiante* estudiante) {
+    if (resto.empty()) {
+        auto encontrado = find(nodo.estudiantes.begin(), nodo.estudiantes.end(), estudiante);
+        if (encontrado == nodo.estudiantes.end()) return false;
+        nodo.estudiantes.erase(encontrado);
+        return true;
+    }
+
+    const size_t posicion = posicion_hijo(nodo, resto[0]);
+    if (posicion == nodo.hijos.size()) return false;
+    Nodo& hijo = *nodo.hijos[posicion];
+    if (resto.substr(0, hijo.etiqueta.size()) != hijo.etiqueta) return false;
+    if (!quitar_recursivo(hijo, resto.substr(hijo.etiqueta.size()), estudiante)) return false;
+
+    if (hijo.estudiantes.empty()) {
+        if (hijo.hijos.empty()) {
+            nodo.hijos.erase(nodo.hijos.begin() + posicion);
+        }
+        else if (hijo.hijos.size() == 1) {
+            unique_ptr<Nodo> nieto = std::move(hijo.hijos[0]);
+            nieto->etiqueta.insert(0, hijo.etiqueta);
+            nodo.hijos[posicion] = std::move(nieto);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Quita un estudiante buscándolo por el nombre con que se indexó.
+ * @param nombre Nombre original (sin plegar).
+ * @param estudiante Puntero a quitar.
+ * @return true si estaba.
+ */
+bool IndiceNombres::quitar(string_view nombre, const Estudiante* estudiante) {
+    if (!quitar_recursivo(raiz_, plegar(nombre), estudiante)) return false;
+    --cantidad_;
+    return true;
+}
+
+// ---------- Consultas ----------
+
+/**
+ * @brief Preorden del subárbol: primero los nombres que terminan en el nodo, luego los hijos.
+ * @param nodo Raíz del subárbol.
+ * @param limite Resultados restantes.
+ * @param visitar Función callback.
+ * @return false al agotar el límite.
+ */
+bool IndiceNombres::recorrer(const Nodo& nodo, size_t& limite, const function<void(const Estudiante&)>& visitar) {
+    for (const Estudiante* estudiante : nodo.estudiantes) {
+        if (limite == 0) return false;
+        visitar(*estudiante);
+        --limite;
+    }
+    for (const unique_ptr<Nodo>& hijo : nodo.hijos) {
+        if (!recorrer(*hijo, limite, visitar)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Baja por el prefijo plegado y recorre el subárbol donde termina.
+ * @param prefijo Prefijo buscado.
+ * @param limite Máximo de resultados.
+ * @param visitar Función callback.
+ * @details
+ * El prefijo puede terminar a mitad de una etiqueta: en ese caso todo el
+ * subárbol de esa arista coincide.
+ */
+void IndiceNombres::buscar_prefijo(string_view prefijo, size_t limite, const function<void(const Estudiante&)>& visitar) const {
+    if (limite == 0) return;
+    const string clave = plegar(prefijo);
+    const Nodo* nodo = &raiz_;
+    string_view resto = clave;
+    while (!resto.empty()) {
+        const size_t posicion = posicion_hijo(*nodo, resto[0]);
+        if (posicion == nodo->hijos.size()) return;
+        const Nodo& hijo = *nodo->hijos[posicion];
+        const size_t comparar = min(resto.size(), hijo.etiqueta.size());
+        if (string_view(hijo.etiqueta).substr(0, comparar) != resto.substr(0, comparar)) return;
+        resto.remove_prefix(comparar);
+        nodo = &hijo;
+    }
+    recorrer(*nodo, limite, visitar);
+}
+
+/**
+ * @brief Cantidad de estudiantes indexados.
+ * @return Entradas en el índice.
+ */
+size_t IndiceNombres::tamano() const { return cantidad_; }
+
+/**
+ * @brief Libera todos los nodos.
+ */
+void IndiceNombres::limpiar() {
+    raiz_.hijos.clear();
+    raiz_.estudiantes.clear();
+    cantidad_ = 0;
+}
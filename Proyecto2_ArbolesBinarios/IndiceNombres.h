@@ -0,0 +1,120 @@
+#pragma once
+#include "Estudiante.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Índice de estudiantes por prefijo de nombre (árbol radix comprimido).
+ * @details
+ * Cada arista guarda un fragmento del nombre y los nodos con un solo hijo
+ * se fusionan con él, así que un nodo o bifurca o tiene estudiantes cuyo
+ * nombre termina ahí. Buscar un prefijo cuesta O(largo del prefijo) hasta
+ * su nodo y O(k) para entregar los k estudiantes de ese subárbol.
+ *
+ * Las claves se guardan plegadas a minúsculas: A-Z y las letras acentuadas
+ * de Latin-1 (À-Þ, salvo ×) se comparan sin distinguir mayúsculas, que es
+ * la codificación de las cadenas del proyecto. Otros bytes se comparan tal cual.
+ *
+ * El índice guarda punteros a estudiantes que viven en otra estructura
+ * (ArbolBinarioBusqueda); quien lo mantiene debe quitar o reconstruir las
+ * entradas cuando esos estudiantes cambian de nombre o de dirección.
+ */
+class IndiceNombres {
+private:
+    /**
+     * @brief Nodo del árbol radix.
+     */
+    struct Nodo {
+        std::string etiqueta;                         ///< fragmento (plegado) desde el padre
+        std::vector<std::unique_ptr<Nodo>> hijos;     ///< ordenados por el primer byte de su etiqueta
+        std::vector<const Estudiante*> estudiantes;   ///< nombres que terminan en este nodo
+    };
+
+    /**
+     * @brief Raíz con etiqueta vacía.
+     */
+    Nodo raiz_;
+
+    /**
+     * @brief Estudiantes indexados.
+     */
+    std::size_t cantidad_;
+
+    /**
+     * @brief Pasa un nombre a la forma en que se guarda y se compara.
+     * @param nombre Nombre o prefijo original.
+     * @return Copia con las mayúsculas ASCII y Latin-1 pasadas a minúsculas.
+     */
+    static std::string plegar(std::string_view nombre);
+
+    /**
+     * @brief Posición del hijo cuya etiqueta empieza con el byte dado.
+     * @param nodo Nodo padre.
+     * @param primero Primer byte buscado.
+     * @return Índice en nodo.hijos del hijo o de donde debería insertarse.
+     */
+    static std::size_t posicion_hijo(const Nodo& nodo, char primero);
+
+    /**
+     * @brief Quita un estudiante del subárbol y fusiona los nodos que quedan sobrantes.
+     * @param nodo Nodo actual.
+     * @param resto Parte de la clave que falta consumir.
+     * @param estudiante Puntero a quitar.
+     * @return true si se encontró.
+     */
+    bool quitar_recursivo(Nodo& nodo, std::string_view resto, const Estudiante* estudiante);
+
+    /**
+     * @brief Entrega los estudiantes de un subárbol en orden, hasta el límite.
+     * @param nodo Raíz del subárbol.
+     * @param limite Resultados que aún se pueden entregar (se descuenta).
+     * @param visitar Función callback para cada estudiante.
+     * @return false si se alcanzó el límite.
+     */
+    static bool recorrer(const Nodo& nodo, std::size_t& limite, const std::function<void(const Estudiante&)>& visitar);
+
+public:
+    /**
+     * @brief Crea un índice vacío.
+     */
+    IndiceNombres();
+
+    /**
+     * @brief Agrega un estudiante bajo su nombre actual.
+     * @param estudiante Estudiante indexado; debe seguir vivo mientras esté en el índice.
+     */
+    void insertar(const Estudiante* estudiante);
+
+    /**
+     * @brief Quita un estudiante que se indexó con el nombre dado.
+     * @param nombre Nombre con el que se insertó (puede diferir del actual).
+     * @param estudiante Puntero a quitar.
+     * @return true si estaba en el índice.
+     */
+    bool quitar(std::string_view nombre, const Estudiante* estudiante);
+
+    /**
+     * @brief Visita los estudiantes cuyo nombre empieza con el prefijo.
+     * @param prefijo Prefijo buscado (no distingue mayúsculas); vacío visita a todos.
+     * @param limite Cantidad máxima de estudiantes a visitar.
+     * @param visitar Función callback para cada estudiante.
+     * @details
+     * Los resultados salen en orden de nombre plegado (por bytes); los
+     * estudiantes con el mismo nombre, en el orden en que se insertaron.
+     */
+    void buscar_prefijo(std::string_view prefijo, std::size_t limite, const std::function<void(const Estudiante&)>& visitar) const;
+
+    /**
+     * @brief Cantidad de estudiantes indexados.
+     */
+    std::size_t tamano() const;
+
+    /**
+     * @brief Elimina todas las entradas.
+     */
+    void limpiar();
+};
@@ -0,0 +1,409 @@
+#include "Replicacion.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * @brief Identificador de lote: los bytes 'A','B','B','R' leídos en little-endian.
+ */
+static const uint32_t MAGIA_LOTE = 0x52424241;
+
+/**
+ * @brief Tamaño de la cabecera de un lote (magia, cantidad, bytes de carga).
+ */
+static const size_t BYTES_CABECERA = 12;
+
+/**
+ * @brief Límite de carga aceptado por el seguidor; protege ante datos corruptos.
+ */
+static const uint32_t MAXIMA_CARGA = 64u << 20;
+
+/**
+ * @brief Carga a partir de la cual el emisor envía el lote aunque falten registros.
+ * @details
+ * Se revisa después de agregar cada registro, así que un lote no pasa de
+ * este valor más un registro de tamaño máximo (dos cadenas de 65535 bytes),
+ * muy por debajo de MAXIMA_CARGA.
+ */
+static const size_t BYTES_POR_LOTE = 1u << 20;
+
+static_assert(BYTES_POR_LOTE + 4 + 8 + 2 * (2 + 0xFFFF) <= MAXIMA_CARGA, "un lote del emisor debe caber en MAXIMA_CARGA");
+
+// ---------- E/S sobre descriptores ----------
+
+#ifndef _WIN32
+/**
+ * @brief Una escritura que reporta EPIPE en lugar de dejar que SIGPIPE termine el proceso.
+ * @param descriptor Descriptor de destino.
+ * @param datos Bytes a escribir.
+ * @param bytes Cantidad de bytes.
+ * @param es_socket true si el descriptor es un socket.
+ * @return Lo mismo que write(); errno queda con el error de la escritura.
+ * @details
+ * En un socket basta send() con MSG_NOSIGNAL. Una tubería no admite esa
+ * bandera: se bloquea SIGPIPE en este hilo durante write() y, si la
+ * escritura lo generó, se consume la señal pendiente antes de restaurar la
+ * máscara. No toca la disposición de la señal para el resto del proceso.
+ */
+static ssize_t escribir_sin_sigpipe(int descriptor, const char* datos, size_t bytes, bool es_socket) {
+#ifdef MSG_NOSIGNAL
+    if (es_socket) return send(descriptor, datos, bytes, MSG_NOSIGNAL);
+#else
+    (void)es_socket;
+#endif
+    sigset_t sigpipe, previa, pendientes;
+    sigemptyset(&sigpipe);
+    sigaddset(&sigpipe, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &sigpipe, &previa);
+    sigpending(&pendientes);
+    const bool ya_pendiente = sigismember(&pendientes, SIGPIPE) == 1;
+
+    const ssize_t escritos = write(descriptor, datos, bytes);
+    const int error = errno;
+    if (escritos < 0 && error == EPIPE && !ya_pendiente) {
+        int senal;
+        sigwait(&sigpipe, &senal);
+    }
+    pthread_sigmask(SIG_SETMASK, &previa, nullptr);
+    errno = error;
+    return escritos;
+}
+#endif
+
+/**
+ * @brief Escribe todos los bytes, reintentando escrituras parciales e interrupciones.
+ * @param descriptor Descriptor de destino.
+ * @param datos Bytes a escribir.
+ * @param bytes Cantidad de bytes.
+ * @param es_socket true si el descriptor es un socket.
+ * @throws std::system_error si la escritura falla (EPIPE si el lector cerró).
+ */
+static void escribir_todo(int descriptor, const char* datos, size_t bytes, bool es_socket) {
+    while (bytes > 0) {
+#ifdef _WIN32
+        (void)es_socket;
+        const int escritos = _write(descriptor, datos, static_cast<unsigned>(bytes > (1u << 30) ? (1u << 30) : bytes));
+#else
+        const ssize_t escritos = escribir_sin_sigpipe(descriptor, datos, bytes, es_socket);
+#endif
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            throw system_error(errno, generic_category(), "EmisorReplicacion: error de escritura");
+        }
+        datos += escritos;
+        bytes -= static_cast<size_t>(escritos);
+    }
+}
+
+/**
+ * @brief Lee exactamente la cantidad pedida salvo que se llegue al fin del flujo.
+ * @param descriptor Descriptor de origen.
+ * @param datos Destino de los bytes.
+ * @param bytes Cantidad a leer.
+ * @return Bytes leídos; menor que bytes solo si el emisor cerró el descriptor.
+ * @throws std::system_error si la lectura falla.
+ */
+static size_t leer_exacto(int descriptor, char* datos, size_t bytes) {
+    size_t total = 0;
+    while (total < bytes) {
+#ifdef _WIN32
+        const int leidos = _read(descriptor, datos + total, static_cast<unsigned>(bytes - total > (1u << 30) ? (1u << 30) : bytes - total));
+#else
+        const ssize_t leidos = read(descriptor, datos + total, bytes - total);
+#endif
+        if (leidos < 0) {
+            if (errno == EINTR) continue;
+            throw system_error(errno, generic_category(), "SeguidorReplicacion: error de lectura");
+        }
+        if (leidos == 0) break;
+        total += static_cast<size_t>(leidos);
+    }
+    return total;
+}
+
+// ---------- Codificación little-endian ----------
+
+/**
+ * @brief Agrega un entero sin signo en little-endian.
+ * @param salida Búfer de destino.
+ * @param valor Valor a escribir.
+ * @param bytes Ancho en bytes (2, 4 u 8).
+ */
+static void anexar_entero(string& salida, uint64_t valor, int bytes) {
+    for (int indice = 0; indice < bytes; ++indice) salida.push_back(static_cast<char>((valor >> (8 * indice)) & 0xFF));
+}
+
+/**
+ * @brief Lee un entero sin signo en little-endian y avanza el cursor.
+ * @param cursor Posición actual; se avanza.
+ * @param fin Fin de la carga.
+ * @param bytes Ancho en bytes.
+ * @return Valor leído.
+ * @throws std::runtime_error si el registro está cortado.
+ */
+static uint64_t leer_entero(const unsigned char*& cursor, const unsigned char* fin, int bytes) {
+    if (fin - cursor < bytes) throw runtime_error("SeguidorReplicacion: registro incompleto");
+    uint64_t valor = 0;
+    for (int indice = 0; indice < bytes; ++indice) valor |= static_cast<uint64_t>(cursor[indice]) << (8 * indice);
+    cursor += bytes;
+    return valor;
+}
+
+/**
+ * @brief Agrega una cadena precedida por su largo en u16.
+ * @param salida Búfer de destino.
+ * @param texto Cadena a escribir.
+ * @throws std::length_error si supera 65535 bytes.
+ */
+static void anexar_texto_corto(string& salida, string_view texto) {
+    if (texto.size() > 0xFFFF) throw length_error("EmisorReplicacion: cadena demasiado larga para el formato");
+    anexar_entero(salida, texto.size(), 2);
+    salida.append(texto);
+}
+
+// ---------- EmisorReplicacion ----------
+
+/**
+ * @brief Crea el emisor y arranca el hilo vaciador.
+ * @param descriptor Descriptor de escritura.
+ * @param registros_por_lote Registros por lote.
+ * @param intervalo_maximo Espera máxima de un registro.
+ */
+EmisorReplicacion::EmisorReplicacion(int descriptor, uint32_t registros_por_lote, chrono::milliseconds intervalo_maximo)
+    : descriptor_(descriptor), es_socket_(false), cantidad_pendiente_(0), registros_por_lote_(registros_por_lote > 0 ? registros_por_lote : 1),
+    intervalo_maximo_(intervalo_maximo), registros_enviados_(0), error_(0), detener_(false) {
+#ifndef _WIN32
+    struct stat informacion;
+    es_socket_ = fstat(descriptor_, &informacion) == 0 && S_ISSOCK(informacion.st_mode);
+#endif
+    carga_.reserve(std::min(static_cast<size_t>(registros_por_lote_) * 48, BYTES_POR_LOTE));
+    vaciador_ = thread([this] { vaciar_por_tiempo(); });
+}
+
+/**
+ * @brief Detiene el hilo y envía lo pendiente; un destructor no debe lanzar.
+ */
+EmisorReplicacion::~EmisorReplicacion() {
+    {
+        lock_guard<mutex> bloqueo(mutex_);
+        detener_ = true;
+    }
+    senal_.notify_one();
+    vaciador_.join();
+    try { vaciar(); }
+    catch (...) {}
+}
+
+/**
+ * @brief Se registra como observador de cambios del árbol.
+ * @param arbol Árbol a replicar.
+ */
+void EmisorReplicacion::conectar(ArbolBinarioBusqueda& arbol) {
+    arbol.set_observador_cambios([this](const Estudiante& estudiante) { registrar(estudiante); });
+}
+
+/**
+ * @brief Espera a que venza el lote en curso y lo envía.
+ * @details
+ * Sin lote pendiente duerme hasta que registrar() avise; con lote, hasta
+ * inicio_lote_ + intervalo_maximo_. Si al despertar el lote sigue siendo el
+ * mismo y ya venció, lo envía. Un error de escritura queda guardado en
+ * error_ y lo recibe la siguiente llamada de quien inserta.
+ */
+void EmisorReplicacion::vaciar_por_tiempo() {
+    unique_lock<mutex> bloqueo(mutex_);
+    while (!detener_) {
+        if (cantidad_pendiente_ == 0 || error_ != 0) {
+            senal_.wait(bloqueo);
+            continue;
+        }
+        const chrono::steady_clock::time_point vencimiento = inicio_lote_ + intervalo_maximo_;
+        if (chrono::steady_clock::now() < vencimiento) {
+            senal_.wait_until(bloqueo, vencimiento);
+            continue;
+        }
+        try { vaciar_con_bloqueo(); }
+        catch (...) {}
+    }
+}
+
+/**
+ * @brief Codifica un estudiante en el lote.
+ * @param estudiante Estudiante a enviar.
+ * @details
+ * Si la codificación falla a la mitad, la carga se recorta al tamaño previo
+ * para no dejar un registro parcial en el lote. El primer registro de un
+ * lote despierta al hilo vaciador para que programe el vencimiento. El lote
+ * se envía al llegar a registros_por_lote_ registros o a BYTES_POR_LOTE de
+ * carga, lo que ocurra primero.
+ */
+void EmisorReplicacion::registrar(const Estudiante& estudiante) {
+    lock_guard<mutex> bloqueo(mutex_);
+    if (error_ != 0) throw system_error(error_, generic_category(), "EmisorReplicacion: flujo roto por un error de escritura anterior");
+
+    const size_t tamano_previo = carga_.size();
+    try {
+        uint64_t bits_promedio;
+        const double promedio = estudiante.promedio();
+        memcpy(&bits_promedio, &promedio, sizeof(bits_promedio));
+        anexar_entero(carga_, static_cast<uint32_t>(estudiante.id()), 4);
+        anexar_entero(carga_, bits_promedio, 8);
+        anexar_texto_corto(carga_, estudiante.nombre());
+        anexar_texto_corto(carga_, estudiante.carrera());
+    }
+    catch (...) {
+        carga_.resize(tamano_previo);
+        throw;
+    }
+    if (++cantidad_pendiente_ == 1) {
+        inicio_lote_ = chrono::steady_clock::now();
+        senal_.notify_one();
+    }
+
+    if (cantidad_pendiente_ >= registros_por_lote_ || carga_.size() >= BYTES_POR_LOTE) vaciar_con_bloqueo();
+}
+
+/**
+ * @brief Envía el lote pendiente tomando el mutex.
+ */
+void EmisorReplicacion::vaciar() {
+    lock_guard<mutex> bloqueo(mutex_);
+    vaciar_con_bloqueo();
+}
+
+/**
+ * @brief Arma la trama (cabecera y carga) y la escribe en una sola llamada al sistema.
+ * @details
+ * La trama se arma en trama_, así que carga_ no cambia si la escritura
+ * falla. Aun así el emisor queda roto: no se sabe cuántos bytes de la
+ * trama llegaron y un reintento desalinearía al seguidor.
+ */
+void EmisorReplicacion::vaciar_con_bloqueo() {
+    if (error_ != 0) throw system_error(error_, generic_category(), "EmisorReplicacion: flujo roto por un error de escritura anterior");
+    if (cantidad_pendiente_ == 0) return;
+    trama_.clear();
+    trama_.reserve(BYTES_CABECERA + carga_.size());
+    anexar_entero(trama_, MAGIA_LOTE, 4);
+    anexar_entero(trama_, cantidad_pendiente_, 4);
+    anexar_entero(trama_, carga_.size(), 4);
+    trama_.append(carga_);
+
+    try {
+        escribir_todo(descriptor_, trama_.data(), trama_.size(), es_socket_);
+    }
+    catch (const system_error& error) {
+        error_ = error.code().value() != 0 ? error.code().value() : EIO;
+        throw;
+    }
+    registros_enviados_ += cantidad_pendiente_;
+    cantidad_pendiente_ = 0;
+    carga_.clear();
+}
+
+/**
+ * @brief Total de registros enviados.
+ * @return Registros escritos en el descriptor.
+ */
+uint64_t EmisorReplicacion::registros_enviados() const {
+    lock_guard<mutex> bloqueo(mutex_);
+    return registros_enviados_;
+}
+
+/**
+ * @brief Indica si el flujo quedó roto.
+ * @return true tras un error de escritura.
+ */
+bool EmisorReplicacion::roto() const {
+    lock_guard<mutex> bloqueo(mutex_);
+    return error_ != 0;
+}
+
+// ---------- SeguidorReplicacion ----------
+
+/**
+ * @brief Crea el seguidor.
+ * @param descriptor Descriptor de lectura.
+ * @param arbol Árbol réplica.
+ */
+SeguidorReplicacion::SeguidorReplicacion(int descriptor, ArbolBinarioBusqueda& arbol)
+    : descriptor_(descriptor), arbol_(arbol), registros_aplicados_(0) {
+}
+
+/**
+ * @brief Lee y aplica un lote.
+ * @return false ante fin de flujo limpio (antes de una cabecera).
+ * @details
+ * Valida la magia, la cantidad y el largo de la carga antes de insertar, y
+ * que la carga se consuma exactamente.
+ */
+bool SeguidorReplicacion::aplicar_lote() {
+    unsigned char cabecera[BYTES_CABECERA];
+    const size_t leidos = leer_exacto(descriptor_, reinterpret_cast<char*>(cabecera), BYTES_CABECERA);
+    if (leidos == 0) return false;
+    if (leidos < BYTES_CABECERA) throw runtime_error("SeguidorReplicacion: cabecera de lote incompleta");
+
+    const unsigned char* cursor = cabecera;
+    const uint32_t magia = static_cast<uint32_t>(leer_entero(cursor, cabecera + BYTES_CABECERA, 4));
+    const uint32_t cantidad = static_cast<uint32_t>(leer_entero(cursor, cabecera + BYTES_CABECERA, 4));
+    const uint32_t bytes_carga = static_cast<uint32_t>(leer_entero(cursor, cabecera + BYTES_CABECERA, 4));
+    if (magia != MAGIA_LOTE) throw runtime_error("SeguidorReplicacion: lote con magia inválida");
+    if (bytes_carga > MAXIMA_CARGA) throw runtime_error("SeguidorReplicacion: lote demasiado grande");
+
+    carga_.resize(bytes_carga);
+    if (leer_exacto(descriptor_, carga_.data(), bytes_carga) < bytes_carga) {
+        throw runtime_error("SeguidorReplicacion: lote cortado");
+    }
+
+    cursor = reinterpret_cast<const unsigned char*>(carga_.data());
+    const unsigned char* fin = cursor + carga_.size();
+    for (uint32_t registro = 0; registro < cantidad; ++registro) {
+        const int id = static_cast<int>(static_cast<uint32_t>(leer_entero(cursor, fin, 4)));
+        const uint64_t bits_promedio = leer_entero(cursor, fin, 8);
+        double promedio;
+        memcpy(&promedio, &bits_promedio, sizeof(promedio));
+
+        const size_t largo_nombre = static_cast<size_t>(leer_entero(cursor, fin, 2));
+        if (static_cast<size_t>(fin - cursor) < largo_nombre) throw runtime_error("SeguidorReplicacion: registro incompleto");
+        string nombre(reinterpret_cast<const char*>(cursor), largo_nombre);
+        cursor += largo_nombre;
+
+        const size_t largo_carrera = static_cast<size_t>(leer_entero(cursor, fin, 2));
+        if (static_cast<size_t>(fin - cursor) < largo_carrera) throw runtime_error("SeguidorReplicacion: registro incompleto");
+        string_view carrera(reinterpret_cast<const char*>(cursor), largo_carrera);
+        cursor += largo_carrera;
+
+        arbol_.emplazar(id, std::move(nombre), carrera, promedio);
+        ++registros_aplicados_;
+    }
+    if (cursor != fin) throw runtime_error("SeguidorReplicacion: bytes sobrantes en el lote");
+    return true;
+}
+
+/**
+ * @brief Aplica lotes hasta el cierre del emisor.
+ * @return Registros aplicados en esta llamada.
+ */
+uint64_t SeguidorReplicacion::aplicar_hasta_cierre() {
+    const uint64_t previos = registros_aplicados_;
+    while (aplicar_lote()) {}
+    return registros_aplicados_ - previos;
+}
+
+/**
+ * @brief Total de registros aplicados.
+ * @return Registros insertados en la réplica.
+ */
+uint64_t SeguidorReplicacion::registros_aplicados() const { return registros_aplicados_; }
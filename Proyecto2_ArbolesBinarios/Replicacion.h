@@ -0,0 +1,247 @@
+#pragma once
+#include "ArbolBinarioBusqueda.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @file Replicacion.h
+ * @brief Flujo de replicación de inserciones entre procesos.
+ * @details
+ * EmisorReplicacion escribe los cambios de un árbol en un descriptor (tubería
+ * o socket Unix) y SeguidorReplicacion los aplica a otro árbol en el proceso
+ * de respaldo. Ambos comparten el formato, por eso viven en el mismo archivo.
+ *
+ * Formato binario, todos los enteros en little-endian:
+ * - Lote: magia u32 ("ABBR"), cantidad de registros u32, bytes de carga u32,
+ *   seguido de la carga.
+ * - Registro: id i32, promedio f64 (bits IEEE-754 como u64), largo del
+ *   nombre u16, nombre, largo de la carrera u16, carrera.
+ * Un estudiante típico ocupa unos 40 bytes y cada lote agrega 12 de cabecera.
+ */
+
+/**
+ * @brief Envía las inserciones y actualizaciones de un árbol a un descriptor.
+ * @details
+ * Acumula registros en un lote y lo escribe completo cuando alcanza la
+ * cantidad configurada o 1 MiB de carga (el seguidor rechaza lotes de más
+ * de 64 MiB), al llamar a vaciar() o cuando el primer registro
+ * pendiente cumple el intervalo máximo de espera. Del vencimiento se encarga
+ * un hilo vaciador propio que duerme hasta ese momento, así que el final de
+ * una ráfaga sale aunque no lleguen más inserciones. Un mutex protege el
+ * lote: registrar() y vaciar() pueden llamarse desde cualquier hilo.
+ *
+ * El lote tiene tamaño acotado y la escritura es bloqueante: si el seguidor
+ * se atrasa y se llena la tubería, el proceso que inserta espera en vez de
+ * acumular memoria sin límite (contrapresión). Si el seguidor muere, la
+ * escritura falla con EPIPE en lugar de terminar el proceso por SIGPIPE.
+ *
+ * Tras cualquier error de escritura el emisor queda roto: parte del lote
+ * pudo haber salido y el seguidor ya no puede sincronizar el flujo, así que
+ * las llamadas siguientes lanzan el mismo error sin escribir nada más.
+ *
+ * Conectado a un árbol, registrar() corre después de que insertar() modificó
+ * el árbol; insertar() no propaga sus excepciones sino que las guarda en
+ * ArbolBinarioBusqueda::error_observador().
+ *
+ * El emisor no es dueño del descriptor: no lo cierra.
+ */
+class EmisorReplicacion {
+private:
+    /**
+     * @brief Descriptor de escritura (tubería o socket).
+     */
+    int descriptor_;
+
+    /**
+     * @brief true si el descriptor es un socket (se escribe con send y MSG_NOSIGNAL).
+     */
+    bool es_socket_;
+
+    /**
+     * @brief Carga del lote en construcción; conserva su capacidad entre lotes.
+     */
+    std::string carga_;
+
+    /**
+     * @brief Cabecera más carga del lote que se está escribiendo.
+     * @details
+     * Se arma aparte para que una escritura fallida no deje la cabecera
+     * pegada a carga_.
+     */
+    std::string trama_;
+
+    /**
+     * @brief Registros en el lote en construcción.
+     */
+    std::uint32_t cantidad_pendiente_;
+
+    /**
+     * @brief Registros a partir de los cuales se envía el lote.
+     */
+    std::uint32_t registros_por_lote_;
+
+    /**
+     * @brief Espera máxima de un registro antes de forzar el envío.
+     */
+    std::chrono::steady_clock::duration intervalo_maximo_;
+
+    /**
+     * @brief Momento en que entró el primer registro del lote actual.
+     */
+    std::chrono::steady_clock::time_point inicio_lote_;
+
+    /**
+     * @brief Total de registros enviados.
+     */
+    std::uint64_t registros_enviados_;
+
+    /**
+     * @brief Código errno de la escritura que rompió el flujo, o 0.
+     */
+    int error_;
+
+    /**
+     * @brief Indica al hilo vaciador que termine.
+     */
+    bool detener_;
+
+    /**
+     * @brief Protege el lote, los contadores y el estado de error.
+     */
+    mutable std::mutex mutex_;
+
+    /**
+     * @brief Despierta al hilo vaciador cuando empieza un lote o al destruir.
+     */
+    std::condition_variable senal_;
+
+    /**
+     * @brief Hilo que envía el lote cuando vence intervalo_maximo_.
+     */
+    std::thread vaciador_;
+
+    /**
+     * @brief Cuerpo del hilo vaciador.
+     */
+    void vaciar_por_tiempo();
+
+    /**
+     * @brief Envía el lote pendiente; requiere mutex_ tomado.
+     * @throws std::system_error si falla la escritura o el emisor ya está roto.
+     */
+    void vaciar_con_bloqueo();
+
+public:
+    /**
+     * @brief Crea un emisor sobre un descriptor abierto para escritura.
+     * @param descriptor Descriptor de la tubería o socket.
+     * @param registros_por_lote Registros por lote (mínimo 1).
+     * @param intervalo_maximo Tiempo máximo que un registro espera en el lote.
+     * @details Arranca el hilo vaciador.
+     */
+    explicit EmisorReplicacion(int descriptor, std::uint32_t registros_por_lote = 512,
+        std::chrono::milliseconds intervalo_maximo = std::chrono::milliseconds(2));
+
+    /**
+     * @brief Destructor; detiene el hilo vaciador y envía el lote pendiente (ignora errores de escritura).
+     */
+    ~EmisorReplicacion();
+
+    EmisorReplicacion(const EmisorReplicacion&) = delete;
+    EmisorReplicacion& operator=(const EmisorReplicacion&) = delete;
+
+    /**
+     * @brief Registra este emisor como observador de cambios del árbol.
+     * @param arbol Árbol a replicar; el emisor debe vivir más que el registro.
+     */
+    void conectar(ArbolBinarioBusqueda& arbol);
+
+    /**
+     * @brief Agrega un estudiante al lote y lo envía si corresponde.
+     * @param estudiante Estudiante insertado o actualizado.
+     * @throws std::length_error si el nombre o la carrera superan 65535 bytes.
+     * @throws std::system_error si falla la escritura o el emisor está roto.
+     */
+    void registrar(const Estudiante& estudiante);
+
+    /**
+     * @brief Envía el lote pendiente, si lo hay.
+     * @throws std::system_error si falla la escritura o el emisor está roto
+     *         (también si el error ocurrió antes en el hilo vaciador).
+     */
+    void vaciar();
+
+    /**
+     * @brief Total de registros enviados hasta ahora.
+     */
+    std::uint64_t registros_enviados() const;
+
+    /**
+     * @brief Indica si un error de escritura rompió el flujo.
+     */
+    bool roto() const;
+};
+
+/**
+ * @brief Aplica a un árbol local los lotes que produce un EmisorReplicacion.
+ * @details
+ * Cada registro se inserta con emplazar(), así que una actualización
+ * reemplaza al estudiante con la misma clave. El árbol del seguidor queda
+ * listo para usarse directamente si el proceso principal falla.
+ */
+class SeguidorReplicacion {
+private:
+    /**
+     * @brief Descriptor de lectura (tubería o socket).
+     */
+    int descriptor_;
+
+    /**
+     * @brief Árbol donde se aplican los cambios.
+     */
+    ArbolBinarioBusqueda& arbol_;
+
+    /**
+     * @brief Búfer de la carga del lote actual; se reutiliza entre lotes.
+     */
+    std::string carga_;
+
+    /**
+     * @brief Total de registros aplicados.
+     */
+    std::uint64_t registros_aplicados_;
+
+public:
+    /**
+     * @brief Crea un seguidor sobre un descriptor abierto para lectura.
+     * @param descriptor Descriptor de la tubería o socket.
+     * @param arbol Árbol réplica.
+     */
+    SeguidorReplicacion(int descriptor, ArbolBinarioBusqueda& arbol);
+
+    SeguidorReplicacion(const SeguidorReplicacion&) = delete;
+    SeguidorReplicacion& operator=(const SeguidorReplicacion&) = delete;
+
+    /**
+     * @brief Lee un lote completo (bloqueante) y lo aplica.
+     * @return false si el emisor cerró el descriptor entre lotes; true en otro caso.
+     * @throws std::runtime_error si el lote está mal formado o cortado a la mitad.
+     * @throws std::system_error si falla la lectura.
+     */
+    bool aplicar_lote();
+
+    /**
+     * @brief Aplica lotes hasta que el emisor cierre el descriptor.
+     * @return Registros aplicados durante la llamada.
+     */
+    std::uint64_t aplicar_hasta_cierre();
+
+    /**
+     * @brief Total de registros aplicados hasta ahora.
+     */
+    std::uint64_t registros_aplicados() const;
+};
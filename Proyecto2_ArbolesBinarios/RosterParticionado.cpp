@@ -0,0 +1,239 @@
+#include "RosterParticionado.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <queue>
+#include <system_error>
+#include <thread>
+#include <tuple>
+
+using namespace std;
+
+/**
+ * @brief Crea las particiones vacías.
+ * @param cantidad_particiones Número de árboles; si es 0 se usa 1.
+ * @param modo Criterio de reparto.
+ */
+RosterParticionado::RosterParticionado(size_t cantidad_particiones, ModoParticion modo) : modo_(modo) {
+    cantidad_particiones = std::max<size_t>(1, cantidad_particiones);
+    particiones_.reserve(cantidad_particiones);
+    for (size_t indice = 0; indice < cantidad_particiones; ++indice) {
+        particiones_.push_back(make_unique<ArbolBinarioBusqueda>());
+    }
+}
+
+// ---------- Reparto ----------
+
+/**
+ * @brief Partición de un promedio: divide 0 - 10000 en intervalos iguales.
+ * @param clave_promedio_cent Promedio en centésimas.
+ * @return Índice de partición.
+ */
+size_t RosterParticionado::particion_por_promedio(int clave_promedio_cent) const {
+    const long long clave = std::clamp(clave_promedio_cent, 0, 10000);
+    return static_cast<size_t>(clave * static_cast<long long>(particiones_.size()) / 10001);
+}
+
+/**
+ * @brief Partición de un ID: multiplica por una constante de Fibonacci
+ *        para dispersar IDs consecutivos.
+ * @param id ID del estudiante.
+ * @return Índice de partición.
+ */
+size_t RosterParticionado::particion_por_id(int id) const {
+    const uint64_t mezcla = static_cast<uint64_t>(static_cast<uint32_t>(id)) * 0x9E3779B97F4A7C15ULL;
+    return static_cast<size_t>((mezcla >> 32) % particiones_.size());
+}
+
+/**
+ * @brief Partición destino de un estudiante.
+ * @param estudiante Estudiante a ubicar.
+ * @return Índice de partición según el modo.
+ */
+size_t RosterParticionado::particion_de(const Estudiante& estudiante) const {
+    if (modo_ == ModoParticion::PorRangoPromedio) {
+        return particion_por_promedio(convertir_promedio_a_clave(estudiante.promedio()));
+    }
+    return particion_por_id(estudiante.id());
+}
+
+// ---------- Inserción ----------
+
+/**
+ * @brief Inserta una copia del estudiante en su partición.
+ * @param estudiante Estudiante a insertar.
+ */
+void RosterParticionado::insertar(const Estudiante& estudiante) {
+    particiones_[particion_de(estudiante)]->insertar(estudiante);
+}
+
+/**
+ * @brief Mueve el estudiante a su partición.
+ * @param estudiante Estudiante a mover.
+ */
+void RosterParticionado::insertar(Estudiante&& estudiante) {
+    const size_t indice = particion_de(estudiante);
+    particiones_[indice]->insertar(std::move(estudiante));
+}
+
+/**
+ * @brief Carga masiva en paralelo.
+ * @param estudiantes Estudiantes a insertar.
+ * @details
+ * Usa tantos hilos como núcleos (sin superar el número de particiones). Cada
+ * hilo reclama la siguiente partición pendiente con un contador atómico y la
+ * llena completa, de modo que dos hilos nunca tocan el mismo árbol.
+ *
+ * Como en clonar_recursivo, la excepción de un hilo se captura en su propio
+ * exception_ptr; ese hilo agota el contador para que los demás no tomen más
+ * particiones, se esperan todos y se relanza la primera en el hilo que llamó.
+ * Si un hilo no se puede crear, los ya creados y el que llama hacen el trabajo.
+ */
+void RosterParticionado::cargar_masivo(vector<Estudiante> estudiantes) {
+    vector<vector<Estudiante>> grupos(particiones_.size());
+    for (Estudiante& estudiante : estudiantes) {
+        const size_t indice = particion_de(estudiante);
+        grupos[indice].push_back(std::move(estudiante));
+    }
+    estudiantes.clear();
+    estudiantes.shrink_to_fit();
+
+    const size_t nucleos = std::max(1u, thread::hardware_concurrency());
+    const size_t cantidad_hilos = std::min(nucleos, particiones_.size());
+    atomic<size_t> siguiente{ 0 };
+    vector<exception_ptr> errores(cantidad_hilos);
+
+    auto trabajar = [&](size_t hilo) {
+        try {
+            for (size_t indice = siguiente++; indice < grupos.size(); indice = siguiente++) {
+                ArbolBinarioBusqueda& arbol = *particiones_[indice];
+                for (Estudiante& estudiante : grupos[indice]) arbol.insertar(std::move(estudiante));
+                vector<Estudiante>().swap(grupos[indice]);
+            }
+        }
+        catch (...) {
+            errores[hilo] = current_exception();
+            siguiente = grupos.size();
+        }
+    };
+
+    vector<thread> hilos;
+    hilos.reserve(cantidad_hilos);
+    try {
+        for (size_t hilo = 1; hilo < cantidad_hilos; ++hilo) hilos.emplace_back(trabajar, hilo);
+    }
+    catch (const system_error&) {}
+    trabajar(0); // el hilo que llama también trabaja
+    for (thread& hilo : hilos) hilo.join();
+    for (exception_ptr& error : errores) {
+        if (error) rethrow_exception(error);
+    }
+}
+
+// ---------- Búsqueda ----------
+
+/**
+ * @brief Busca por promedio exacto.
+ * @param promedio Promedio a buscar.
+ * @return Estudiante encontrado o nullptr.
+ * @details
+ * En modo por rango consulta solo la partición del promedio; en modo por
+ * hash recorre las particiones hasta encontrar una coincidencia.
+ */
+const Estudiante* RosterParticionado::buscar_por_promedio(double promedio) {
+    if (modo_ == ModoParticion::PorRangoPromedio) {
+        return particiones_[particion_por_promedio(convertir_promedio_a_clave(promedio))]->buscar_por_promedio(promedio);
+    }
+    for (unique_ptr<ArbolBinarioBusqueda>& arbol : particiones_) {
+        const Estudiante* encontrado = arbol->buscar_por_promedio(promedio);
+        if (encontrado != nullptr) return encontrado;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Busca por ID.
+ * @param id ID a buscar.
+ * @return Estudiante encontrado o nullptr.
+ * @details
+ * En modo por hash consulta solo la partición del ID; en modo por rango
+ * recorre las particiones hasta encontrarlo.
+ */
+const Estudiante* RosterParticionado::buscar_por_id(int id) {
+    if (modo_ == ModoParticion::PorHashId) {
+        return particiones_[particion_por_id(id)]->buscar_por_id(id);
+    }
+    for (unique_ptr<ArbolBinarioBusqueda>& arbol : particiones_) {
+        const Estudiante* encontrado = arbol->buscar_por_id(id);
+        if (encontrado != nullptr) return encontrado;
+    }
+    return nullptr;
+}
+
+// ---------- Recorrido ----------
+
+/**
+ * @brief Inorden global del roster.
+ * @param visitar Función callback para cada estudiante.
+ * @details
+ * En modo por hash, cada partición aporta su inorden como un vector de
+ * punteros y un montículo de mínimos elige en cada paso la menor clave
+ * (promedio en centésimas, ID) entre las cabezas de las k listas.
+ */
+void RosterParticionado::inorden(const function<void(const Estudiante&)>& visitar) const {
+    if (modo_ == ModoParticion::PorRangoPromedio) {
+        for (const unique_ptr<ArbolBinarioBusqueda>& arbol : particiones_) arbol->inorden_it(visitar);
+        return;
+    }
+
+    vector<vector<const Estudiante*>> listas(particiones_.size());
+    for (size_t indice = 0; indice < particiones_.size(); ++indice) {
+        listas[indice].reserve(static_cast<size_t>(particiones_[indice]->contar_nodos()));
+        particiones_[indice]->inorden_it([&listas, indice](const Estudiante& estudiante) {
+            listas[indice].push_back(&estudiante);
+            });
+    }
+
+    // (clave promedio, id, partición, posición)
+    using Cabeza = tuple<int, int, size_t, size_t>;
+    priority_queue<Cabeza, vector<Cabeza>, greater<Cabeza>> cabezas;
+    for (size_t indice = 0; indice < listas.size(); ++indice) {
+        if (listas[indice].empty()) continue;
+        const Estudiante* primero = listas[indice][0];
+        cabezas.push({ convertir_promedio_a_clave(primero->promedio()), primero->id(), indice, 0 });
+    }
+    while (!cabezas.empty()) {
+        auto [clave, id, lista, posicion] = cabezas.top();
+        cabezas.pop();
+        visitar(*listas[lista][posicion]);
+        if (++posicion < listas[lista].size()) {
+            const Estudiante* siguiente = listas[lista][posicion];
+            cabezas.push({ convertir_promedio_a_clave(siguiente->promedio()), siguiente->id(), lista, posicion });
+        }
+    }
+}
+
+// ---------- Consulta ----------
+
+/**
+ * @brief Total de estudiantes.
+ * @return Suma de los nodos de todas las particiones.
+ */
+int RosterParticionado::contar_nodos() const {
+    int total = 0;
+    for (const unique_ptr<ArbolBinarioBusqueda>& arbol : particiones_) total += arbol->contar_nodos();
+    return total;
+}
+
+/**
+ * @brief Número de particiones.
+ * @return Cantidad de árboles.
+ */
+size_t RosterParticionado::cantidad_particiones() const { return particiones_.size(); }
+
+/**
+ * @brief Partición por índice.
+ * @param indice Índice de la partición.
+ * @return Referencia constante al árbol.
+ */
+const ArbolBinarioBusqueda& RosterParticionado::particion(size_t indice) const { return *particiones_.at(indice); }
@@ -0,0 +1,147 @@
+#pragma once
+#include "ArbolBinarioBusqueda.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+/**
+ * @brief Criterio con el que RosterParticionado reparte a los estudiantes.
+ */
+enum class ModoParticion {
+    /**
+     * @brief Cada partición cubre un intervalo contiguo de promedios.
+     * @details
+     * Las búsquedas por promedio van a una sola partición y el inorden global
+     * es la concatenación de las particiones; las búsquedas por ID consultan todas.
+     */
+    PorRangoPromedio,
+
+    /**
+     * @brief La partición se elige con un hash del ID.
+     * @details
+     * Reparte la carga de forma pareja aunque los promedios estén concentrados.
+     * Las búsquedas por ID van a una sola partición; las de promedio y el
+     * inorden global consultan todas.
+     */
+    PorHashId
+};
+
+/**
+ * @brief Lista de estudiantes repartida en varios ArbolBinarioBusqueda independientes.
+ * @details
+ * Cada partición es un árbol propio, así que la carga masiva inserta en todas
+ * las particiones en paralelo (un hilo por partición, hasta el número de núcleos)
+ * y el rendimiento de ingesta crece con los núcleos disponibles.
+ *
+ * Solo cargar_masivo() trabaja en paralelo internamente; el resto de las
+ * operaciones no es seguro para llamarse desde varios hilos a la vez.
+ */
+class RosterParticionado {
+private:
+    /**
+     * @brief Criterio de reparto.
+     */
+    ModoParticion modo_;
+
+    /**
+     * @brief Árboles de cada partición.
+     * @details
+     * Se guardan por puntero porque ArbolBinarioBusqueda no se puede copiar.
+     */
+    std::vector<std::unique_ptr<ArbolBinarioBusqueda>> particiones_;
+
+    /**
+     * @brief Partición que corresponde a un promedio (modo PorRangoPromedio).
+     * @param clave_promedio_cent Promedio en centésimas; se acota a 0 - 10000.
+     * @return Índice de partición.
+     */
+    size_t particion_por_promedio(int clave_promedio_cent) const;
+
+    /**
+     * @brief Partición que corresponde a un ID (modo PorHashId).
+     * @param id ID del estudiante.
+     * @return Índice de partición.
+     */
+    size_t particion_por_id(int id) const;
+
+    /**
+     * @brief Partición destino de un estudiante según el modo activo.
+     * @param estudiante Estudiante a ubicar.
+     * @return Índice de partición.
+     */
+    size_t particion_de(const Estudiante& estudiante) const;
+
+public:
+    /**
+     * @brief Crea un roster vacío.
+     * @param cantidad_particiones Número de árboles (mínimo 1).
+     * @param modo Criterio de reparto.
+     */
+    RosterParticionado(size_t cantidad_particiones, ModoParticion modo);
+
+    /**
+     * @brief Inserta un estudiante en su partición.
+     * @param estudiante Estudiante a insertar (se copia una vez).
+     */
+    void insertar(const Estudiante& estudiante);
+
+    /**
+     * @brief Inserta un estudiante moviéndolo a su partición.
+     * @param estudiante Estudiante a mover.
+     */
+    void insertar(Estudiante&& estudiante);
+
+    /**
+     * @brief Inserta muchos estudiantes usando todas las particiones en paralelo.
+     * @param estudiantes Estudiantes a cargar; se mueven a los árboles.
+     * @details
+     * Primero agrupa a los estudiantes por partición (secuencial, O(n)) y luego
+     * cada hilo toma particiones completas y las llena con insertar(Estudiante&&).
+     * Como ningún árbol es compartido entre hilos, no se necesitan candados.
+     * Si una inserción lanza, se esperan todos los hilos y la excepción se
+     * relanza aquí; las particiones quedan con lo que alcanzó a insertarse y
+     * los estudiantes que faltaban se pierden con el vector recibido.
+     */
+    void cargar_masivo(std::vector<Estudiante> estudiantes);
+
+    /**
+     * @brief Busca un estudiante por promedio exacto.
+     * @param promedio Promedio en escala 0.0 - 100.0.
+     * @return Estudiante encontrado o nullptr.
+     */
+    const Estudiante* buscar_por_promedio(double promedio);
+
+    /**
+     * @brief Busca un estudiante por ID.
+     * @param id ID del estudiante.
+     * @return Estudiante encontrado o nullptr.
+     */
+    const Estudiante* buscar_por_id(int id);
+
+    /**
+     * @brief Recorre todos los estudiantes en orden global de (promedio, ID).
+     * @param visitar Función callback para cada estudiante.
+     * @details
+     * Por rango de promedio basta con recorrer las particiones en orden. Por
+     * hash de ID se obtiene el inorden de cada partición y se mezclan con un
+     * montículo (mezcla de k vías), en O(n log k).
+     */
+    void inorden(const std::function<void(const Estudiante&)>& visitar) const;
+
+    /**
+     * @brief Cantidad total de estudiantes en todas las particiones.
+     */
+    int contar_nodos() const;
+
+    /**
+     * @brief Número de particiones.
+     */
+    size_t cantidad_particiones() const;
+
+    /**
+     * @brief Acceso de solo lectura a una partición.
+     * @param indice Índice de la partición.
+     * @return Referencia al árbol de esa partición.
+     */
+    const ArbolBinarioBusqueda& particion(size_t indice) const;
+};
@@ -0,0 +1,66 @@
+#include "SalidaBufferizada.h"
+#include <charconv>
+
+using namespace std;
+
+/**
+ * @brief Crea la salida y reserva el búfer una sola vez.
+ * @param destino Flujo de salida.
+ * @param capacidad Umbral de volcado en bytes.
+ * @details
+ * Se reserva un poco más que la capacidad para que la última línea agregada
+ * antes de volcar no provoque una nueva reserva.
+ */
+SalidaBufferizada::SalidaBufferizada(ostream& destino, size_t capacidad)
+    : destino_(destino), capacidad_(capacidad) {
+    buffer_.reserve(capacidad_ + 512);
+}
+
+/**
+ * @brief Vacía el contenido pendiente antes de destruir la salida.
+ */
+SalidaBufferizada::~SalidaBufferizada() { vaciar(); }
+
+/**
+ * @brief Agrega un estudiante seguido de un salto de línea.
+ * @param estudiante Estudiante a escribir.
+ */
+void SalidaBufferizada::escribir(const Estudiante& estudiante) {
+    estudiante.anexar_texto(buffer_);
+    buffer_.push_back('\n');
+    if (buffer_.size() >= capacidad_) vaciar();
+}
+
+/**
+ * @brief Agrega un estudiante con el prefijo de su nivel.
+ * @param estudiante Estudiante a escribir.
+ * @param nivel Nivel del nodo en el árbol.
+ */
+void SalidaBufferizada::escribir(const Estudiante& estudiante, int nivel) {
+    char numero[16];
+    buffer_.append("[Nivel ");
+    to_chars_result resultado = to_chars(numero, numero + sizeof(numero), nivel);
+    buffer_.append(numero, resultado.ptr);
+    buffer_.append("] ");
+    escribir(estudiante);
+}
+
+/**
+ * @brief Agrega texto libre al búfer.
+ * @param texto Texto a escribir.
+ */
+void SalidaBufferizada::escribir(string_view texto) {
+    buffer_.append(texto);
+    if (buffer_.size() >= capacidad_) vaciar();
+}
+
+/**
+ * @brief Escribe el búfer completo en el destino con una sola llamada.
+ * @details
+ * clear() conserva la capacidad reservada, por lo que el búfer se reutiliza.
+ */
+void SalidaBufferizada::vaciar() {
+    if (buffer_.empty()) return;
+    destino_.write(buffer_.data(), static_cast<streamsize>(buffer_.size()));
+    buffer_.clear();
+}
@@ -0,0 +1,71 @@
+#pragma once
+#include "Estudiante.h"
+#include <ostream>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Salida en bloque para listados grandes de estudiantes.
+ * @details
+ * Acumula el texto de muchos estudiantes en un único búfer reutilizable y lo
+ * envía al flujo de destino en bloques grandes, en lugar de hacer una escritura
+ * (y una cadena temporal) por estudiante. El búfer se vacía automáticamente al
+ * superar la capacidad indicada y al destruirse el objeto.
+ */
+class SalidaBufferizada {
+private:
+    /**
+     * @brief Flujo donde se vuelca el contenido acumulado.
+     */
+    std::ostream& destino_;
+
+    /**
+     * @brief Texto pendiente de escribir; conserva su capacidad entre vaciados.
+     */
+    std::string buffer_;
+
+    /**
+     * @brief Tamaño a partir del cual el búfer se vuelca al destino.
+     */
+    size_t capacidad_;
+
+public:
+    /**
+     * @brief Crea una salida en bloque sobre un flujo existente.
+     * @param destino Flujo de salida (por ejemplo std::cout).
+     * @param capacidad Bytes a acumular antes de escribir; por defecto 64 KB.
+     */
+    explicit SalidaBufferizada(std::ostream& destino, size_t capacidad = 1 << 16);
+
+    /**
+     * @brief Destructor; escribe lo que quede pendiente.
+     */
+    ~SalidaBufferizada();
+
+    SalidaBufferizada(const SalidaBufferizada&) = delete;
+    SalidaBufferizada& operator=(const SalidaBufferizada&) = delete;
+
+    /**
+     * @brief Agrega un estudiante en una línea, con el formato de Estudiante::a_texto().
+     * @param estudiante Estudiante a escribir.
+     */
+    void escribir(const Estudiante& estudiante);
+
+    /**
+     * @brief Agrega un estudiante precedido por su nivel en el árbol.
+     * @param estudiante Estudiante a escribir.
+     * @param nivel Nivel del nodo, mostrado como "[Nivel n] ".
+     */
+    void escribir(const Estudiante& estudiante, int nivel);
+
+    /**
+     * @brief Agrega texto libre sin salto de línea.
+     * @param texto Texto a escribir.
+     */
+    void escribir(std::string_view texto);
+
+    /**
+     * @brief Envía al destino todo el contenido acumulado.
+     */
+    void vaciar();
+};
@@ -0,0 +1,260 @@
+#include "TablaColumnar.h"
+#include <algorithm>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define TABLA_COLUMNAR_SSE2 1
+#endif
+
+using namespace std;
+
+// ---------- ResumenColumnar ----------
+
+/**
+ * @brief Media de los promedios filtrados.
+ * @return Media en escala 0.0 - 100.0, o 0.0 si el resumen está vacío.
+ */
+double ResumenColumnar::media() const {
+    if (cantidad == 0) return 0.0;
+    return static_cast<double>(suma_cent) / cantidad / 100.0;
+}
+
+/**
+ * @brief Varianza poblacional de los promedios filtrados.
+ * @return Varianza en escala 0.0 - 100.0 (unidades al cuadrado), o 0.0 si está vacío.
+ * @details
+ * Se calcula como E[x^2] - E[x]^2 sobre las centésimas y luego se reescala.
+ */
+double ResumenColumnar::varianza() const {
+    if (cantidad == 0) return 0.0;
+    const double media_cent = static_cast<double>(suma_cent) / cantidad;
+    const double varianza_cent = static_cast<double>(suma_cuadrados) / cantidad - media_cent * media_cent;
+    return std::max(0.0, varianza_cent) / 10000.0;
+}
+
+// ---------- Carga ----------
+
+/**
+ * @brief Agrega un estudiante a las tres columnas.
+ * @param estudiante Estudiante de origen.
+ */
+void TablaColumnar::agregar(const Estudiante& estudiante) {
+    ids_.push_back(estudiante.id());
+    promedios_cent_.push_back(convertir_promedio_a_clave(estudiante.promedio()));
+    codigos_carrera_.push_back(estudiante.codigo_carrera());
+}
+
+/**
+ * @brief Carga la tabla con todos los estudiantes del árbol.
+ * @param arbol Árbol de origen.
+ * @details
+ * Reserva las columnas con el tamaño del árbol y lo recorre en inorden
+ * iterativo, de modo que las filas quedan ordenadas por (promedio, id).
+ */
+void TablaColumnar::cargar_desde(const ArbolBinarioBusqueda& arbol) {
+    limpiar();
+    const size_t cantidad = static_cast<size_t>(arbol.contar_nodos());
+    ids_.reserve(cantidad);
+    promedios_cent_.reserve(cantidad);
+    codigos_carrera_.reserve(cantidad);
+    arbol.inorden_it([this](const Estudiante& estudiante) { agregar(estudiante); });
+}
+
+/**
+ * @brief Vacía las tres columnas.
+ */
+void TablaColumnar::limpiar() {
+    ids_.clear();
+    promedios_cent_.clear();
+    codigos_carrera_.clear();
+}
+
+/**
+ * @brief Cantidad de filas de la tabla.
+ * @return Número de estudiantes cargados.
+ */
+size_t TablaColumnar::tamano() const { return promedios_cent_.size(); }
+
+// ---------- Agregaciones ----------
+
+/**
+ * @brief Resume los promedios de una carrera (o de todas) en una pasada.
+ * @param codigo_carrera Código de carrera o TODAS_LAS_CARRERAS.
+ * @return Cantidad, suma, suma de cuadrados, mínimo y máximo.
+ * @details
+ * Versión SSE2: procesa cuatro filas por iteración.
+ * - La máscara de carrera se obtiene extendiendo cuatro códigos de 16 a 32
+ *   bits y comparándolos con el código buscado.
+ * - La suma y la suma de cuadrados se acumulan en carriles de 64 bits para
+ *   no desbordar con millones de filas.
+ * - Mínimo y máximo se seleccionan con máscaras (SSE2 no tiene min/max de
+ *   enteros de 32 bits); las filas filtradas aportan INT_MAX / INT_MIN.
+ * Las filas sobrantes (menos de cuatro) y las plataformas sin SSE2 usan el
+ * mismo cálculo escalar.
+ */
+ResumenColumnar TablaColumnar::resumir(int codigo_carrera) const {
+    const size_t total = promedios_cent_.size();
+    const int32_t* promedios = promedios_cent_.data();
+    const uint16_t* codigos = codigos_carrera_.data();
+    const bool filtrar = codigo_carrera != TODAS_LAS_CARRERAS;
+
+    int64_t cantidad = 0, suma = 0, suma_cuadrados = 0;
+    int32_t minimo = numeric_limits<int32_t>::max();
+    int32_t maximo = numeric_limits<int32_t>::min();
+    size_t indice = 0;
+
+#ifdef TABLA_COLUMNAR_SSE2
+    const __m128i cero = _mm_setzero_si128();
+    const __m128i todos = _mm_set1_epi32(-1);
+    const __m128i objetivo = _mm_set1_epi32(codigo_carrera);
+    const __m128i neutro_minimo = _mm_set1_epi32(numeric_limits<int32_t>::max());
+    const __m128i neutro_maximo = _mm_set1_epi32(numeric_limits<int32_t>::min());
+
+    __m128i conteo = cero;
+    __m128i suma_baja = cero, suma_alta = cero, cuadrados = cero;
+    __m128i minimos = neutro_minimo, maximos = neutro_maximo;
+
+    for (; indice + 4 <= total; indice += 4) {
+        const __m128i valores = _mm_loadu_si128(reinterpret_cast<const __m128i*>(promedios + indice));
+        __m128i mascara = todos;
+        if (filtrar) {
+            const __m128i codigos16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(codigos + indice));
+            mascara = _mm_cmpeq_epi32(_mm_unpacklo_epi16(codigos16, cero), objetivo);
+        }
+
+        conteo = _mm_sub_epi32(conteo, mascara); // la máscara vale -1 en filas incluidas
+
+        const __m128i incluidos = _mm_and_si128(valores, mascara);
+        const __m128i signo = _mm_srai_epi32(incluidos, 31);
+        suma_baja = _mm_add_epi64(suma_baja, _mm_unpacklo_epi32(incluidos, signo));
+        suma_alta = _mm_add_epi64(suma_alta, _mm_unpackhi_epi32(incluidos, signo));
+
+        const __m128i absolutos = _mm_sub_epi32(_mm_xor_si128(incluidos, signo), signo);
+        cuadrados = _mm_add_epi64(cuadrados, _mm_mul_epu32(absolutos, absolutos));
+        const __m128i impares = _mm_srli_epi64(absolutos, 32);
+        cuadrados = _mm_add_epi64(cuadrados, _mm_mul_epu32(impares, impares));
+
+        const __m128i para_minimo = _mm_or_si128(incluidos, _mm_andnot_si128(mascara, neutro_minimo));
+        const __m128i menor = _mm_cmplt_epi32(para_minimo, minimos);
+        minimos = _mm_or_si128(_mm_and_si128(menor, para_minimo), _mm_andnot_si128(menor, minimos));
+
+        const __m128i para_maximo = _mm_or_si128(incluidos, _mm_andnot_si128(mascara, neutro_maximo));
+        const __m128i mayor = _mm_cmpgt_epi32(para_maximo, maximos);
+        maximos = _mm_or_si128(_mm_and_si128(mayor, para_maximo), _mm_andnot_si128(mayor, maximos));
+    }
+
+    alignas(16) int32_t carriles32[4];
+    alignas(16) int64_t carriles64[2];
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(carriles32), conteo);
+    for (int32_t carril : carriles32) cantidad += static_cast<uint32_t>(carril);
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(carriles64), _mm_add_epi64(suma_baja, suma_alta));
+    suma += carriles64[0] + carriles64[1];
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(carriles64), cuadrados);
+    suma_cuadrados += carriles64[0] + carriles64[1];
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(carriles32), minimos);
+    for (int32_t carril : carriles32) minimo = std::min(minimo, carril);
+
+    _mm_store_si128(reinterpret_cast<__m128i*>(carriles32), maximos);
+    for (int32_t carril : carriles32) maximo = std::max(maximo, carril);
+#endif
+
+    for (; indice < total; ++indice) {
+        if (filtrar && codigos[indice] != codigo_carrera) continue;
+        const int32_t valor = promedios[indice];
+        ++cantidad;
+        suma += valor;
+        suma_cuadrados += static_cast<int64_t>(valor) * valor;
+        minimo = std::min(minimo, valor);
+        maximo = std::max(maximo, valor);
+    }
+
+    ResumenColumnar resumen;
+    resumen.cantidad = cantidad;
+    resumen.suma_cent = suma;
+    resumen.suma_cuadrados = suma_cuadrados;
+    resumen.minimo_cent = cantidad > 0 ? minimo : 0;
+    resumen.maximo_cent = cantidad > 0 ? maximo : 0;
+    return resumen;
+}
+
+/**
+ * @brief Resume todas las carreras en una sola pasada sobre las columnas.
+ * @return Resumen por código de carrera (posición = código).
+ * @details
+ * Agrupar por carrera no se presta a SIMD, pero un solo recorrido secuencial
+ * sigue siendo mucho más barato que llamar a resumir() una vez por carrera.
+ */
+vector<ResumenColumnar> TablaColumnar::resumir_por_carrera() const {
+    uint16_t codigo_mayor = 0;
+    for (uint16_t codigo : codigos_carrera_) codigo_mayor = std::max(codigo_mayor, codigo);
+
+    vector<ResumenColumnar> resumenes(promedios_cent_.empty() ? 0 : codigo_mayor + 1);
+    for (ResumenColumnar& resumen : resumenes) {
+        resumen.minimo_cent = numeric_limits<int32_t>::max();
+        resumen.maximo_cent = numeric_limits<int32_t>::min();
+    }
+    for (size_t indice = 0; indice < promedios_cent_.size(); ++indice) {
+        ResumenColumnar& resumen = resumenes[codigos_carrera_[indice]];
+        const int32_t valor = promedios_cent_[indice];
+        ++resumen.cantidad;
+        resumen.suma_cent += valor;
+        resumen.suma_cuadrados += static_cast<int64_t>(valor) * valor;
+        resumen.minimo_cent = std::min(resumen.minimo_cent, valor);
+        resumen.maximo_cent = std::max(resumen.maximo_cent, valor);
+    }
+    for (ResumenColumnar& resumen : resumenes) {
+        if (resumen.cantidad == 0) resumen.minimo_cent = resumen.maximo_cent = 0;
+    }
+    return resumenes;
+}
+
+/**
+ * @brief Construye el histograma de promedios.
+ * @param ancho_cubeta_cent Ancho de cubeta en centésimas (mínimo 1).
+ * @param codigo_carrera Código de carrera o TODAS_LAS_CARRERAS.
+ * @return Conteos por cubeta.
+ */
+vector<uint64_t> TablaColumnar::histograma(int ancho_cubeta_cent, int codigo_carrera) const {
+    ancho_cubeta_cent = std::max(1, ancho_cubeta_cent);
+    const int cubetas = 10000 / ancho_cubeta_cent + 1;
+    const bool filtrar = codigo_carrera != TODAS_LAS_CARRERAS;
+
+    vector<uint64_t> parciales(static_cast<size_t>(cubetas) * 4, 0);
+    const size_t total = promedios_cent_.size();
+    for (size_t indice = 0; indice < total; ++indice) {
+        if (filtrar && codigos_carrera_[indice] != codigo_carrera) continue;
+        const int cubeta = std::clamp(promedios_cent_[indice] / ancho_cubeta_cent, 0, cubetas - 1);
+        ++parciales[static_cast<size_t>(cubeta) * 4 + (indice & 3)];
+    }
+
+    vector<uint64_t> resultado(cubetas, 0);
+    for (int cubeta = 0; cubeta < cubetas; ++cubeta) {
+        for (int copia = 0; copia < 4; ++copia) resultado[cubeta] += parciales[static_cast<size_t>(cubeta) * 4 + copia];
+    }
+    return resultado;
+}
+
+// ---------- Acceso ----------
+
+/**
+ * @brief Columna de IDs.
+ * @return Referencia constante al arreglo de IDs.
+ */
+const vector<int32_t>& TablaColumnar::ids() const { return ids_; }
+
+/**
+ * @brief Columna de promedios en centésimas.
+ * @return Referencia constante al arreglo de promedios.
+ */
+const vector<int32_t>& TablaColumnar::promedios_cent() const { return promedios_cent_; }
+
+/**
+ * @brief Columna de códigos de carrera.
+ * @return Referencia constante al arreglo de códigos.
+ */
+const vector<uint16_t>& TablaColumnar::codigos_carrera() const { return codigos_carrera_; }
@@ -0,0 +1,131 @@
+#pragma once
+#include "ArbolBinarioBusqueda.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Resumen estadístico de una columna de promedios.
+ * @details
+ * Los valores se guardan en centésimas (igual que las claves del árbol);
+ * media() y varianza() los devuelven en la escala 0.0 - 100.0.
+ */
+struct ResumenColumnar {
+    std::int64_t cantidad = 0;         ///< estudiantes que cumplen el filtro
+    std::int64_t suma_cent = 0;        ///< suma de promedios en centésimas
+    std::int64_t suma_cuadrados = 0;   ///< suma de cuadrados en centésimas^2
+    std::int32_t minimo_cent = 0;      ///< menor promedio (0 si cantidad == 0)
+    std::int32_t maximo_cent = 0;      ///< mayor promedio (0 si cantidad == 0)
+
+    /**
+     * @brief Media de los promedios en escala 0.0 - 100.0.
+     * @return La media, o 0.0 si no hay estudiantes.
+     */
+    double media() const;
+
+    /**
+     * @brief Varianza poblacional de los promedios en escala 0.0 - 100.0.
+     * @return La varianza, o 0.0 si no hay estudiantes.
+     */
+    double varianza() const;
+};
+
+/**
+ * @brief Tabla columnar (estructura de arreglos) de estudiantes para análisis.
+ * @details
+ * Guarda en arreglos contiguos e independientes el id, el promedio en
+ * centésimas y el código de carrera de cada estudiante. Las agregaciones
+ * recorren la memoria de forma secuencial y, en x86/x64, procesan cuatro
+ * estudiantes por instrucción con SSE2, sin llamadas a std::function por nodo.
+ *
+ * Es un complemento de ArbolBinarioBusqueda, no un reemplazo: se carga con
+ * cargar_desde() y refleja el árbol en ese momento, por lo que debe volver a
+ * cargarse tras nuevas inserciones.
+ */
+class TablaColumnar {
+private:
+    /**
+     * @brief IDs de los estudiantes.
+     */
+    std::vector<std::int32_t> ids_;
+
+    /**
+     * @brief Promedios en centésimas (misma clave que el árbol).
+     */
+    std::vector<std::int32_t> promedios_cent_;
+
+    /**
+     * @brief Códigos de carrera del diccionario compartido.
+     */
+    std::vector<std::uint16_t> codigos_carrera_;
+
+public:
+    /**
+     * @brief Valor de filtro que incluye a todas las carreras.
+     */
+    static const int TODAS_LAS_CARRERAS = -1;
+
+    /**
+     * @brief Agrega un estudiante al final de la tabla.
+     * @param estudiante Estudiante a copiar en las columnas.
+     */
+    void agregar(const Estudiante& estudiante);
+
+    /**
+     * @brief Reemplaza el contenido por los estudiantes del árbol, en inorden.
+     * @param arbol Árbol de origen.
+     */
+    void cargar_desde(const ArbolBinarioBusqueda& arbol);
+
+    /**
+     * @brief Elimina todas las filas.
+     */
+    void limpiar();
+
+    /**
+     * @brief Cantidad de filas de la tabla.
+     */
+    size_t tamano() const;
+
+    /**
+     * @brief Calcula cantidad, suma, suma de cuadrados, mínimo y máximo en una sola pasada.
+     * @param codigo_carrera Código de carrera a incluir o TODAS_LAS_CARRERAS.
+     * @return Resumen de los promedios filtrados.
+     * @details
+     * El filtro se aplica como máscara dentro del mismo ciclo vectorial,
+     * sin ramas por estudiante.
+     */
+    ResumenColumnar resumir(int codigo_carrera = TODAS_LAS_CARRERAS) const;
+
+    /**
+     * @brief Calcula el resumen de cada carrera en una sola pasada.
+     * @return Vector indexado por código de carrera.
+     */
+    std::vector<ResumenColumnar> resumir_por_carrera() const;
+
+    /**
+     * @brief Histograma de promedios con cubetas de ancho fijo.
+     * @param ancho_cubeta_cent Ancho de cada cubeta en centésimas (por ejemplo 100 = un punto).
+     * @param codigo_carrera Código de carrera a incluir o TODAS_LAS_CARRERAS.
+     * @return Conteo por cubeta sobre el rango 0 - 10000; los valores fuera
+     *         del rango se acumulan en la primera o la última cubeta.
+     * @details
+     * Usa cuatro histogramas parciales intercalados para que incrementos
+     * consecutivos sobre la misma cubeta no se serialicen, y los suma al final.
+     */
+    std::vector<std::uint64_t> histograma(int ancho_cubeta_cent, int codigo_carrera = TODAS_LAS_CARRERAS) const;
+
+    /**
+     * @brief Acceso de solo lectura a la columna de IDs.
+     */
+    const std::vector<std::int32_t>& ids() const;
+
+    /**
+     * @brief Acceso de solo lectura a la columna de promedios en centésimas.
+     */
+    const std::vector<std::int32_t>& promedios_cent() const;
+
+    /**
+     * @brief Acceso de solo lectura a la columna de códigos de carrera.
+     */
+    const std::vector<std::uint16_t>& codigos_carrera() const;
+};
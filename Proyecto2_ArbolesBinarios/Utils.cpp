@@ -1,35 +1,43 @@
 #include "Utils.h"
+#include "SalidaBufferizada.h"
 #include <iostream>
 #include <limits>
+#include <cmath>
 
 using namespace std;
 
 /**
- * @brief Imprime la informacin de un estudiante en una sola lnea.
+ * @brief Imprime la información de un estudiante en una sola línea.
  * @param estudiante Referencia constante al estudiante a imprimir.
  * @details
- * Utiliza el mtodo a_texto() del Estudiante para generar una cadena
- * formateada y la enva a la salida estndar seguida de un salto de lnea.
+ * Formatea el estudiante con anexar_texto() sobre un búfer estático que se
+ * reutiliza entre llamadas, evitando crear una cadena nueva por estudiante,
+ * y lo envía a la salida estándar seguido de un salto de línea.
  */
 void Utils::imprimir_estudiante(const Estudiante& estudiante) {
-    cout << estudiante.a_texto() << "\n";
+    static string linea;
+    linea.clear();
+    estudiante.anexar_texto(linea);
+    linea.push_back('\n');
+    cout.write(linea.data(), static_cast<streamsize>(linea.size()));
 }
 
 /**
- * @brief Imprime la informacin de un estudiante junto con su nivel en el rbol.
+ * @brief Imprime la información de un estudiante junto con su nivel en el árbol.
  * @param estudiante Referencia constante al estudiante a imprimir.
- * @param nivel Nivel en el que se encuentra el estudiante dentro del rbol.
+ * @param nivel Nivel en el que se encuentra el estudiante dentro del árbol.
  * @details
  * El nivel se muestra entre corchetes como un prefijo, seguido de la
- * representacin textual del estudiante.
+ * representación textual del estudiante.
  */
 void Utils::imprimir_estudiante_con_nivel(const Estudiante& estudiante, int nivel) {
-    cout << "[Nivel " << nivel << "] " << estudiante.a_texto() << "\n";
+    cout << "[Nivel " << nivel << "] ";
+    imprimir_estudiante(estudiante);
 }
 
 /**
- * @brief Ejecuta una demostracin completa del uso del rbol binario de bsqueda.
- * @param arbol Referencia al rbol sobre el cual se realizar la demo.
+ * @brief Ejecuta una demostración completa del uso del árbol binario de búsqueda.
+ * @param arbol Referencia al árbol sobre el cual se realizará la demo.
  * @details
  * Inserta siete estudiantes con promedios predefinidos (50, 30, 70, 20, 40, 60, 80),
  * luego muestra:
@@ -37,8 +45,8 @@ void Utils::imprimir_estudiante_con_nivel(const Estudiante& estudiante, int nive
  * - Recorridos PreOrden recursivo e iterativo.
  * - Recorridos PostOrden recursivo e iterativo.
  * - Recorrido por niveles (BFS) indicando el nivel de cada nodo.
- * - Mtricas del rbol (altura, nodos, hojas, internos, ancho mximo).
- * Finalmente refleja el rbol, imprime el InOrden (invertido) y vuelve a reflejar
+ * - Métricas del árbol (altura, nodos, hojas, internos, ancho máximo).
+ * Finalmente refleja el árbol, imprime el InOrden (invertido) y vuelve a reflejar
  * para restaurar la forma original.
  */
 void Utils::ejecutar_demo(ArbolBinarioBusqueda& arbol) {
@@ -47,7 +55,7 @@ void Utils::ejecutar_demo(ArbolBinarioBusqueda& arbol) {
     double promedios_demo[7] = { 50,30,70,20,40,60,80 };
     string nombres_demo[7] = { "Ana","Beto","Carla","Diego","Elena","Fabio","Gina" };
     for (int indice = 0; indice < 7; ++indice) {
-        arbol.insertar(Estudiante(ids_demo[indice], nombres_demo[indice], "Ingeniera", promedios_demo[indice]));
+        arbol.insertar(Estudiante(ids_demo[indice], nombres_demo[indice], "Ingeniería", promedios_demo[indice]));
     }
 
     cout << "\n- InOrden (recursivo):\n";
@@ -68,12 +76,12 @@ void Utils::ejecutar_demo(ArbolBinarioBusqueda& arbol) {
         Utils::imprimir_estudiante_con_nivel(estudiante, nivel);
         });
 
-    cout << "\n- Mtricas:\n";
+    cout << "\n- Métricas:\n";
     cout << "Altura: " << arbol.altura() << "\n";
     cout << "Nodos totales: " << arbol.contar_nodos() << "\n";
     cout << "Hojas: " << arbol.contar_hojas() << "\n";
     cout << "Internos: " << arbol.contar_internos() << "\n";
-    cout << "Ancho mximo: " << arbol.ancho_maximo() << "\n";
+    cout << "Ancho máximo: " << arbol.ancho_maximo() << "\n";
 
     cout << "\n- Reflejar e imprimir InOrden (invertido):\n";
     arbol.reflejar();
@@ -84,15 +92,15 @@ void Utils::ejecutar_demo(ArbolBinarioBusqueda& arbol) {
 }
 
 /**
- * @brief Solicita los datos de un estudiante por consola e inserta en el rbol.
- * @param arbol Referencia al rbol donde se insertar el nuevo estudiante.
+ * @brief Solicita los datos de un estudiante por consola e inserta en el árbol.
+ * @param arbol Referencia al árbol donde se insertará el nuevo estudiante.
  * @details
  * Pide al usuario:
  * - ID (entero)
- * - Nombre (lnea completa)
- * - Carrera (lnea completa)
+ * - Nombre (línea completa)
+ * - Carrera (línea completa)
  * - Promedio (0-100)
- * Luego crea un objeto Estudiante con esos datos y lo inserta en el rbol.
+ * Luego crea un objeto Estudiante con esos datos y lo inserta en el árbol.
  */
 void Utils::agregar_estudiante(ArbolBinarioBusqueda& arbol) {
     int id_ingresado;
@@ -118,11 +126,11 @@ void Utils::agregar_estudiante(ArbolBinarioBusqueda& arbol) {
 }
 
 /**
- * @brief Realiza una bsqueda de estudiante por promedio exacto.
- * @param arbol Referencia al rbol donde se realizar la bsqueda.
+ * @brief Realiza una búsqueda de estudiante por promedio exacto.
+ * @param arbol Referencia al árbol donde se realizará la búsqueda.
  * @details
  * Pide al usuario un promedio en la consola, lo utiliza para buscar
- * en el rbol mediante buscar_por_promedio y muestra el resultado si
+ * en el árbol mediante buscar_por_promedio y muestra el resultado si
  * existe un estudiante con ese promedio.
  */
 void Utils::buscar_por_promedio(ArbolBinarioBusqueda& arbol) {
@@ -140,10 +148,10 @@ void Utils::buscar_por_promedio(ArbolBinarioBusqueda& arbol) {
 }
 
 /**
- * @brief Realiza una bsqueda de estudiante por ID.
- * @param arbol Referencia al rbol donde se realizar la bsqueda.
+ * @brief Realiza una búsqueda de estudiante por ID.
+ * @param arbol Referencia al árbol donde se realizará la búsqueda.
  * @details
- * Pide al usuario un ID, lo utiliza para buscar en el rbol mediante
+ * Pide al usuario un ID, lo utiliza para buscar en el árbol mediante
  * buscar_por_id y muestra el estudiante encontrado o un mensaje si
  * no existe coincidencia.
  */
@@ -157,20 +165,49 @@ void Utils::buscar_por_id(ArbolBinarioBusqueda& arbol) {
         cout << "Encontrado: " << resultado->a_texto() << "\n";
     }
     else {
-        cout << "No se encontr el ID indicado.\n";
+        cout << "No se encontró el ID indicado.\n";
     }
 }
 
 /**
- * @brief Muestra un submen de recorridos y los ejecuta segn la opcin elegida.
- * @param arbol Referencia al rbol cuyos recorridos se desean listar.
+ * @brief Lista los estudiantes cuyo nombre empieza con un prefijo.
+ * @param arbol Referencia al árbol donde se realizará la búsqueda.
+ * @details
+ * Lee el prefijo como línea completa (puede incluir espacios), consulta
+ * buscar_por_prefijo y muestra hasta 50 coincidencias en orden alfabético.
+ */
+void Utils::buscar_por_prefijo(ArbolBinarioBusqueda& arbol) {
+    const size_t maximo_resultados = 50;
+    string prefijo_busqueda;
+    cin.ignore(numeric_limits<streamsize>::max(), '\n');
+    cout << "Prefijo del nombre: ";
+    getline(cin, prefijo_busqueda);
+
+    const vector<const Estudiante*> resultados = arbol.buscar_por_prefijo(prefijo_busqueda, maximo_resultados + 1);
+    if (resultados.empty()) {
+        cout << "No hay estudiantes cuyo nombre empiece con ese prefijo.\n";
+        return;
+    }
+    for (size_t indice = 0; indice < resultados.size() && indice < maximo_resultados; ++indice) {
+        imprimir_estudiante(*resultados[indice]);
+    }
+    if (resultados.size() > maximo_resultados) {
+        cout << "(se muestran los primeros " << maximo_resultados << ")\n";
+    }
+}
+
+/**
+ * @brief Muestra un submenú de recorridos y los ejecuta según la opción elegida.
+ * @param arbol Referencia al árbol cuyos recorridos se desean listar.
  * @details
  * Ofrece opciones para:
  * - InOrden, PreOrden y PostOrden recursivo.
  * - InOrden, PreOrden y PostOrden iterativo.
  * - Recorrido por niveles (BFS).
- * Segn la opcin ingresada, se invoca el recorrido correspondiente y
- * se imprimen los estudiantes en el orden resultante.
+ * Según la opción ingresada, se invoca el recorrido correspondiente y
+ * se imprimen los estudiantes en el orden resultante. El listado se escribe
+ * a través de una SalidaBufferizada, que formatea sin reservas de memoria y
+ * vuelca la consola en bloques grandes en lugar de una vez por estudiante.
  */
 void Utils::listar_recorridos(ArbolBinarioBusqueda& arbol) {
     int opcion_listado;
@@ -182,73 +219,139 @@ void Utils::listar_recorridos(ArbolBinarioBusqueda& arbol) {
         << "5) PreOrden (iterativo)\n"
         << "6) PostOrden (iterativo)\n"
         << "7) Por niveles (BFS)\n"
-        << "Opcin: ";
+        << "Opción: ";
     cin >> opcion_listado;
 
     cout << "\n--- Listado ---\n";
+    SalidaBufferizada salida(cout);
+    auto escribir = [&salida](const Estudiante& estudiante) { salida.escribir(estudiante); };
     switch (opcion_listado) {
-    case 1: arbol.inorden_rec(imprimir_estudiante); break;
-    case 2: arbol.preorden_rec(imprimir_estudiante); break;
-    case 3: arbol.postorden_rec(imprimir_estudiante); break;
-    case 4: arbol.inorden_it(imprimir_estudiante); break;
-    case 5: arbol.preorden_it(imprimir_estudiante); break;
-    case 6: arbol.postorden_it(imprimir_estudiante); break;
+    case 1: arbol.inorden_rec(escribir); break;
+    case 2: arbol.preorden_rec(escribir); break;
+    case 3: arbol.postorden_rec(escribir); break;
+    case 4: arbol.inorden_it(escribir); break;
+    case 5: arbol.preorden_it(escribir); break;
+    case 6: arbol.postorden_it(escribir); break;
     case 7:
-        arbol.por_niveles([](const Estudiante& estudiante, int nivel) {
-            Utils::imprimir_estudiante_con_nivel(estudiante, nivel);
+        arbol.por_niveles([&salida](const Estudiante& estudiante, int nivel) {
+            salida.escribir(estudiante, nivel);
             });
         break;
     default:
-        cout << "Opcin invlida.\n";
+        cout << "Opción inválida.\n";
         break;
     }
 }
 
 /**
- * @brief Muestra las mtricas principales del rbol binario de bsqueda.
- * @param arbol Referencia al rbol a analizar.
+ * @brief Muestra las métricas principales del árbol binario de búsqueda.
+ * @param arbol Referencia al árbol a analizar.
  * @details
  * Imprime:
- * - Altura del rbol.
- * - Nmero total de nodos.
- * - Nmero de hojas.
- * - Nmero de nodos internos.
- * - Ancho mximo (mayor nmero de nodos en un mismo nivel).
+ * - Altura del árbol.
+ * - Número total de nodos.
+ * - Número de hojas.
+ * - Número de nodos internos.
+ * - Ancho máximo (mayor número de nodos en un mismo nivel).
  */
 void Utils::mostrar_metricas(ArbolBinarioBusqueda& arbol) {
-    cout << "\nMtricas del rbol:\n";
+    cout << "\nMétricas del árbol:\n";
     cout << "Altura: " << arbol.altura() << "\n";
     cout << "Nodos totales: " << arbol.contar_nodos() << "\n";
     cout << "Hojas: " << arbol.contar_hojas() << "\n";
     cout << "Internos: " << arbol.contar_internos() << "\n";
-    cout << "Ancho mximo: " << arbol.ancho_maximo() << "\n";
+    cout << "Ancho máximo: " << arbol.ancho_maximo() << "\n";
 }
 
 /**
- * @brief Aplica la operacin de reflejo sobre el rbol y notifica al usuario.
- * @param arbol Referencia al rbol que se desea reflejar.
+ * @brief Aplica la operación de reflejo sobre el árbol y notifica al usuario.
+ * @param arbol Referencia al árbol que se desea reflejar.
  * @details
- * Llama al mtodo reflejar del rbol, que intercambia los subrboles izquierdo
- * y derecho en cada nodo, y luego muestra un mensaje indicando que la operacin
+ * Llama al método reflejar del árbol, que intercambia los subárboles izquierdo
+ * y derecho en cada nodo, y luego muestra un mensaje indicando que la operación
  * se ha realizado.
  */
 void Utils::reflejar_arbol(ArbolBinarioBusqueda& arbol) {
     arbol.reflejar();
-    cout << "-> rbol reflejado.\n";
+    cout << "-> Árbol reflejado.\n";
+}
+
+/**
+ * @brief Imprime los contadores de una categoría de operación.
+ * @param nombre Nombre de la operación a mostrar.
+ * @param contadores Contadores acumulados de esa operación.
+ */
+static void imprimir_contadores(const char* nombre, const ContadoresOperacion& contadores) {
+    cout << nombre << ": llamadas=" << contadores.llamadas
+        << " comparaciones=" << contadores.comparaciones
+        << " visitas=" << contadores.visitas
+        << " asignaciones=" << contadores.asignaciones;
+    if (contadores.llamadas > 0) {
+        cout << " (visitas/llamada=" << static_cast<double>(contadores.visitas) / contadores.llamadas << ")";
+    }
+    cout << "\n";
+}
+
+/**
+ * @brief Muestra la instrumentación acumulada del árbol.
+ * @param arbol Referencia al árbol cuyas estadísticas se mostrarán.
+ * @details
+ * Imprime los contadores por tipo de operación y el histograma de profundidad
+ * de las búsquedas por promedio. Compara la profundidad promedio observada
+ * con log2(n) + 1 para advertir si el árbol se ha degenerado.
+ */
+void Utils::mostrar_estadisticas(ArbolBinarioBusqueda& arbol) {
+    const EstadisticasArbol& estadisticas = arbol.estadisticas();
+    if (!estadisticas.habilitadas) {
+        cout << "\nInstrumentación deshabilitada: compile con ABB_ESTADISTICAS (configuración Debug).\n";
+        return;
+    }
+
+    cout << "\nEstadísticas de operaciones:\n";
+    imprimir_contadores("Inserción", estadisticas.insercion);
+    imprimir_contadores("Búsqueda por promedio", estadisticas.busqueda_promedio);
+    imprimir_contadores("Búsqueda por ID", estadisticas.busqueda_id);
+    imprimir_contadores("Recorridos", estadisticas.recorrido);
+
+    cout << "\nHistograma de profundidad (búsqueda por promedio):\n";
+    uint64_t total_busquedas = 0;
+    uint64_t suma_profundidades = 0;
+    for (int profundidad = 0; profundidad < EstadisticasArbol::CUBETAS_PROFUNDIDAD; ++profundidad) {
+        const uint64_t cantidad = estadisticas.histograma_profundidad[profundidad];
+        if (cantidad == 0) continue;
+        total_busquedas += cantidad;
+        suma_profundidades += cantidad * profundidad;
+        cout << (profundidad == EstadisticasArbol::CUBETAS_PROFUNDIDAD - 1 ? ">=" : "  ")
+            << profundidad << ": " << cantidad << "\n";
+    }
+    if (total_busquedas == 0) {
+        cout << "(sin búsquedas registradas)\n";
+        return;
+    }
+
+    const int nodos = arbol.contar_nodos();
+    const double profundidad_promedio = static_cast<double>(suma_profundidades) / total_busquedas;
+    const double profundidad_ideal = nodos > 0 ? std::log2(static_cast<double>(nodos)) + 1.0 : 0.0;
+    cout << "Profundidad promedio: " << profundidad_promedio
+        << " (ideal ~" << profundidad_ideal << " para " << nodos << " nodos)\n";
+    if (profundidad_promedio > 3.0 * profundidad_ideal) {
+        cout << "-> Advertencia: el árbol parece degenerado.\n";
+    }
 }
 
 /**
- * @brief Muestra y gestiona el men principal de la aplicacin.
+ * @brief Muestra y gestiona el menú principal de la aplicación.
  * @details
- * Configura la sincronizacin de E/S estndar para mejorar el rendimiento
+ * Configura la sincronización de E/S estándar para mejorar el rendimiento
  * en consola y deshabilita el enlace cin/cout.
  *
- * Crea un rbol binario de bsqueda vaco y entra en un bucle donde:
- * - Muestra el men de opciones.
- * - Lee la opcin del usuario.
- * - Ejecuta la accin correspondiente (demo, agregar, buscar, listar,
- *   mostrar mtricas, reflejar).
- * El bucle termina cuando el usuario elige la opcin 0 (Salir).
+ * Crea un árbol binario de búsqueda vacío y entra en un bucle donde:
+ * - Muestra el menú de opciones.
+ * - Lee la opción del usuario.
+ * - Ejecuta la acción correspondiente (demo, agregar, buscar, listar,
+ *   mostrar métricas, reflejar, ver estadísticas de operaciones, buscar
+ *   por prefijo de nombre).
+ * El bucle termina cuando el usuario elige la opción 0 (Salir).
  */
 void Utils::mostrar_menu_principal() {
     ios::sync_with_stdio(false);
@@ -263,10 +366,12 @@ void Utils::mostrar_menu_principal() {
             << "3) Buscar por promedio\n"
             << "4) Buscar por ID\n"
             << "5) Listar (DFS/BFS)\n"
-            << "6) Ver mtricas\n"
-            << "7) Reflejar rbol\n"
+            << "6) Ver métricas\n"
+            << "7) Reflejar árbol\n"
+            << "8) Ver estadísticas de operaciones\n"
+            << "9) Buscar por prefijo de nombre\n"
             << "0) Salir\n"
-            << "Opcin: ";
+            << "Opción: ";
         cin >> opcion_menu;
 
         switch (opcion_menu) {
@@ -277,8 +382,10 @@ void Utils::mostrar_menu_principal() {
         case 5: listar_recorridos(arbol); break;
         case 6: mostrar_metricas(arbol); break;
         case 7: reflejar_arbol(arbol); break;
+        case 8: mostrar_estadisticas(arbol); break;
+        case 9: buscar_por_prefijo(arbol); break;
         case 0: cout << "Saliendo...\n"; break;
-        default: cout << "Opcin invlida.\n"; break;
+        default: cout << "Opción inválida.\n"; break;
         }
     } while (opcion_menu != 0);
 }
@@ -2,30 +2,30 @@
 #include "ArbolBinarioBusqueda.h"
 
 /**
- * @brief Clase de utilidades para manejar la interfaz de usuario y las operaciones sobre el rbol.
+ * @brief Clase de utilidades para manejar la interfaz de usuario y las operaciones sobre el árbol.
  * @details
- * La clase Utils concentra las funciones estticas que gestionan:
- * - El men principal de la aplicacin.
- * - Las acciones asociadas a cada opcin del men.
- * - La interaccin con el usuario para agregar, buscar y listar estudiantes.
- * - La impresin formateada de estudiantes y de recorridos del rbol.
+ * La clase Utils concentra las funciones estáticas que gestionan:
+ * - El menú principal de la aplicación.
+ * - Las acciones asociadas a cada opción del menú.
+ * - La interacción con el usuario para agregar, buscar y listar estudiantes.
+ * - La impresión formateada de estudiantes y de recorridos del árbol.
  */
 class Utils {
 public:
     /**
      * @brief Punto de entrada del flujo de interfaz de usuario (UI).
      * @details
-     * Muestra el men principal en consola y gestiona el ciclo de opciones,
+     * Muestra el menú principal en consola y gestiona el ciclo de opciones,
      * delegando en las funciones privadas las acciones correspondientes.
      */
     static void mostrar_menu_principal();
 
 private:
-    // Acciones del men
+    // Acciones del menú
 
     /**
-     * @brief Ejecuta una demostracin predefinida sobre el rbol.
-     * @param arbol Referencia al rbol binario de bsqueda a utilizar.
+     * @brief Ejecuta una demostración predefinida sobre el árbol.
+     * @param arbol Referencia al árbol binario de búsqueda a utilizar.
      * @details
      * Suele cargar datos de ejemplo, realizar inserciones y mostrar
      * algunos recorridos para ilustrar el funcionamiento del sistema.
@@ -33,17 +33,17 @@ private:
     static void ejecutar_demo(ArbolBinarioBusqueda& arbol);
 
     /**
-     * @brief Permite agregar un nuevo estudiante al rbol.
-     * @param arbol Referencia al rbol donde se insertar el estudiante.
+     * @brief Permite agregar un nuevo estudiante al árbol.
+     * @param arbol Referencia al árbol donde se insertará el estudiante.
      * @details
      * Usualmente solicita los datos del estudiante por consola y los
-     * inserta en el rbol con base en su promedio e ID.
+     * inserta en el árbol con base en su promedio e ID.
      */
     static void agregar_estudiante(ArbolBinarioBusqueda& arbol);
 
     /**
-     * @brief Realiza una bsqueda de estudiante por promedio.
-     * @param arbol Referencia al rbol donde se realizar la bsqueda.
+     * @brief Realiza una búsqueda de estudiante por promedio.
+     * @param arbol Referencia al árbol donde se realizará la búsqueda.
      * @details
      * Solicita al usuario un promedio, lo convierte a la clave interna
      * y muestra el estudiante encontrado si existe una coincidencia exacta.
@@ -51,59 +51,78 @@ private:
     static void buscar_por_promedio(ArbolBinarioBusqueda& arbol);
 
     /**
-     * @brief Realiza una bsqueda de estudiante por ID.
-     * @param arbol Referencia al rbol donde se realizar la bsqueda.
+     * @brief Realiza una búsqueda de estudiante por ID.
+     * @param arbol Referencia al árbol donde se realizará la búsqueda.
      * @details
-     * Pide al usuario un ID y recorre el rbol para localizar al
+     * Pide al usuario un ID y recorre el árbol para localizar al
      * estudiante con dicho identificador, mostrando el resultado.
      */
     static void buscar_por_id(ArbolBinarioBusqueda& arbol);
 
     /**
-     * @brief Lista los estudiantes del rbol utilizando distintos recorridos.
-     * @param arbol Referencia al rbol cuyos recorridos se mostrarn.
+     * @brief Busca estudiantes por el inicio de su nombre.
+     * @param arbol Referencia al árbol donde se realizará la búsqueda.
+     * @details
+     * Pide un prefijo (sin distinguir mayúsculas) y lista los estudiantes
+     * cuyo nombre empieza con él, usando el índice de nombres del árbol.
+     */
+    static void buscar_por_prefijo(ArbolBinarioBusqueda& arbol);
+
+    /**
+     * @brief Lista los estudiantes del árbol utilizando distintos recorridos.
+     * @param arbol Referencia al árbol cuyos recorridos se mostrarán.
      * @details
      * Puede invocar recorridos en preorden, inorden, postorden o por niveles,
-     * y utilizar funciones de impresin para mostrar cada estudiante.
+     * y utilizar funciones de impresión para mostrar cada estudiante.
      */
     static void listar_recorridos(ArbolBinarioBusqueda& arbol);
 
     /**
-     * @brief Muestra mtricas del rbol binario de bsqueda.
-     * @param arbol Referencia al rbol a analizar.
+     * @brief Muestra métricas del árbol binario de búsqueda.
+     * @param arbol Referencia al árbol a analizar.
      * @details
-     * Imprime informacin como altura, nmero de nodos, hojas, nodos internos
-     * y ancho mximo, ayudando a entender la estructura actual del rbol.
+     * Imprime información como altura, número de nodos, hojas, nodos internos
+     * y ancho máximo, ayudando a entender la estructura actual del árbol.
      */
     static void mostrar_metricas(ArbolBinarioBusqueda& arbol);
 
     /**
-     * @brief Aplica la operacin de reflejo sobre el rbol.
-     * @param arbol Referencia al rbol a reflejar.
+     * @brief Aplica la operación de reflejo sobre el árbol.
+     * @param arbol Referencia al árbol a reflejar.
      * @details
-     * Intercambia los subrboles izquierdo y derecho de cada nodo, generando
+     * Intercambia los subárboles izquierdo y derecho de cada nodo, generando
      * una imagen especular de la estructura original.
      */
     static void reflejar_arbol(ArbolBinarioBusqueda& arbol);
 
-    // Impresin
+    /**
+     * @brief Muestra los contadores de operaciones y el histograma de profundidad.
+     * @param arbol Referencia al árbol cuya instrumentación se mostrará.
+     * @details
+     * Permite detectar un árbol degenerado a partir de números reales:
+     * compara la profundidad promedio de búsqueda con log2(n).
+     * Requiere compilar con ABB_ESTADISTICAS; en otro caso lo indica.
+     */
+    static void mostrar_estadisticas(ArbolBinarioBusqueda& arbol);
+
+    // Impresión
 
     /**
-     * @brief Imprime la informacin de un estudiante en formato legible.
+     * @brief Imprime la información de un estudiante en formato legible.
      * @param estudiante Referencia constante al estudiante a imprimir.
      * @details
-     * Suele delegar en el mtodo a_texto() de Estudiante o construir un
+     * Suele delegar en el método a_texto() de Estudiante o construir un
      * formato similar para mostrar su ID, nombre, carrera y promedio.
      */
     static void imprimir_estudiante(const Estudiante& estudiante);
 
     /**
-     * @brief Imprime la informacin de un estudiante junto con su nivel en el rbol.
+     * @brief Imprime la información de un estudiante junto con su nivel en el árbol.
      * @param estudiante Referencia constante al estudiante a imprimir.
-     * @param nivel Nivel del rbol en el que se encuentra el estudiante.
+     * @param nivel Nivel del árbol en el que se encuentra el estudiante.
      * @details
-     * Es til para recorridos por niveles (BFS), donde el nivel indica la
-     * profundidad relativa del nodo dentro del rbol.
+     * Es útil para recorridos por niveles (BFS), donde el nivel indica la
+     * profundidad relativa del nodo dentro del árbol.
      */
     static void imprimir_estudiante_con_nivel(const Estudiante& estudiante, int nivel);
 };